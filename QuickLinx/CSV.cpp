@@ -1,12 +1,34 @@
 ﻿#include "CSV.h"
+#include "CSVTokenizer.h"
+#include "CSVScan.h"
+#include "MappedFile.h"
+#include "IPv4.h"
+#include "CSVEncoding.h"
+#include "CSVCache.h"
+#include "CSVRunStore.h"
+#include "Diagnostics.h"
+#include "CSVWriter.h"
+#include "ScratchArena.h"
 
-#include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <iterator>
 #include <cwctype>
-#include <map>
 #include <unordered_map>
-#include <unordered_set>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 //Helper Functions in anonymous namespace
 namespace 
@@ -49,647 +71,1798 @@ namespace
 		return ss.str();
 	}
 
-	// Parse an IPv4 string into "base" (first three octets + dot) and "host" (last octet)
-	// e.g. "a.b.c.d" -> base="a.b.c.", host=d
-	bool parse_ip_last_octet(	const std::wstring& ip,
-								std::wstring& base,
-								int& host)
+	inline unsigned lowest_bit64(std::uint64_t mask) noexcept
 	{
-		std::wstring s = ip;
-		trim(s);
-		if (s.empty())
-			return false;
+	#if defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanForward64(&index, mask);
+		return index;
+	#else
+		return static_cast<unsigned>(__builtin_ctzll(mask));
+	#endif
+	}
 
-		auto dot_pos = s.find_last_of(L'.');
-		if (dot_pos == std::wstring::npos)
-			return false;
+	// Bits lo..hi (inclusive, both within one 64-bit word) set
+	inline std::uint64_t word_mask(int lo, int hi) noexcept
+	{
+		const std::uint64_t upper = (hi == 63) ? ~std::uint64_t(0) : ((std::uint64_t(1) << (hi + 1)) - 1);
+		return upper & ~((std::uint64_t(1) << lo) - 1);
+	}
 
-		base = s.substr(0, dot_pos + 1);       // "a.b.c."
-		std::wstring tail = s.substr(dot_pos + 1);
-		trim(tail);
-		if (tail.empty())
-			return false;
+	// Hosts present in one /24: bit h of words[] is host h
+	struct SubnetBits
+	{
+		std::uint32_t	subnet = 0;			// address with the host octet cleared
+		std::uint64_t	words[4] = {};
+	};
 
-		try
-		{
-			host = std::stoi(tail);
-		}
-		catch (...)
+	// First host >= from whose bit equals want, or 256 if none
+	inline int next_host(const SubnetBits& bits, int from, bool want) noexcept
+	{
+		if (from >= 256)
+			return 256;
+
+		int word = from >> 6;
+		std::uint64_t mask = (want ? bits.words[word] : ~bits.words[word]) & (~std::uint64_t(0) << (from & 63));
+		while (mask == 0)
 		{
-			return false;
+			if (++word == 4)
+				return 256;
+			mask = want ? bits.words[word] : ~bits.words[word];
 		}
+		return word * 64 + static_cast<int>(lowest_bit64(mask));
+	}
 
-		if (host < 0 || host > 255)
-			return false;
-
-		return true;
+	// Text order of two subnets' "a.b.c." prefixes (the order exports list them in)
+	bool subnet_text_less(std::uint32_t a, std::uint32_t b) noexcept
+	{
+		char text_a[16];
+		char text_b[16];
+		const std::size_t len_a = IPv4::format(a, text_a) - 1;		// keep "a.b.c." - drop the host "0"
+		const std::size_t len_b = IPv4::format(b, text_b) - 1;
+		return std::string_view(text_a, len_a) < std::string_view(text_b, len_b);
 	}
 
+	// One driver's nodes as export rows: entries that are not IPv4
+	// addresses (kept as text) and contiguous address ranges.
+	// The remaining members are scratch space reused between drivers.
+	struct DriverRanges
+	{
+		std::vector<std::wstring>	other;
+		std::vector<IPv4::Range>	ranges;
+
+		std::vector<SubnetBits>		subnets;
+	};
+
 	// Convert node list to one or more ranges.
-	// Each result is either "base.start-end" or "base.host".
+	// Each range is either "base.start-end" or "base.host".
 	// Different subnets (different base) become separate ranges.
-	std::vector<std::wstring> nodes_to_ranges(const std::vector<std::wstring>& nodes)
+	//
+	// Hosts are marked in a 256-bit map per /24, which dedupes them
+	// for free; runs are then read off with bit scans, so no sorting
+	// is needed.
+	void nodes_to_ranges(		const EthDriver& driver,
+								DriverRanges& out)
 	{
-		std::vector<std::wstring> results;
-		if (nodes.empty())
-			return results;
+		out.other.clear();
+		out.ranges.clear();
+		out.subnets.clear();
 
-		// Group hosts by subnet base, e.g. "192.168.1."
-		struct NodeInfo { int host; };
-		std::map<std::wstring, std::vector<NodeInfo>> groups;
-
-		for (auto ip : nodes)
+		// Entries that aren't IPv4 are each their own "range"
+		for (const TextNode& node : driver.extra_nodes)
 		{
-			std::wstring base;
-			int host = 0;
-			if (!parse_ip_last_octet(ip, base, host))
-			{
-				// If it doesn't parse as IPv4, treat it as its own "range"
-				trim(ip);
-				if (!ip.empty())
-					results.push_back(ip);
-				continue;
-			}
-
-			groups[base].push_back({ host });
+			std::wstring text = node.text;
+			trim(text);
+			if (!text.empty())
+				out.other.push_back(std::move(text));
 		}
 
-		// For each subnet, build contiguous ranges
-		for (auto& [base, hosts] : groups)
-		{
-			if (hosts.empty())
-				continue;
+		if (driver.nodes.empty())
+			return;
 
-			// Sort and dedupe
-			std::sort(hosts.begin(), hosts.end(),
-				[](const NodeInfo& a, const NodeInfo& b) {
-					return a.host < b.host;
-				});
-			hosts.erase(std::unique(hosts.begin(), hosts.end(),
-				[](const NodeInfo& a, const NodeInfo& b) {
-					return a.host == b.host;
-				}),
-				hosts.end());
+		std::size_t last_subnet = 0;
+		for (const std::uint32_t address : driver.nodes)
+		{
+			const std::uint32_t subnet = address & 0xFFFFFF00u;
 
-			// Walk and form ranges
-			size_t i = 0;
-			while (i < hosts.size())
+			// Nodes of one subnet usually sit together, so try the last one first
+			if (out.subnets.empty() || out.subnets[last_subnet].subnet != subnet)
 			{
-				int start = hosts[i].host;
-				int end = start;
+				last_subnet = 0;
+				while (last_subnet < out.subnets.size() && out.subnets[last_subnet].subnet != subnet)
+					++last_subnet;
 
-				while (i + 1 < hosts.size() && hosts[i + 1].host == end + 1)
+				if (last_subnet == out.subnets.size())
 				{
-					++i;
-					end = hosts[i].host;
+					out.subnets.emplace_back();
+					out.subnets.back().subnet = subnet;
 				}
+			}
 
-				// Build "base.start" or "base.start-end"
-				std::wstringstream ss;
-				if (start == end)
-				{
-					ss << base << start;
-				}
-				else
-				{
-					ss << base << start << L"-" << end;
-				}
-				results.push_back(ss.str());
+			const std::uint32_t host = address & 0xFF;
+			out.subnets[last_subnet].words[host >> 6] |= std::uint64_t(1) << (host & 63);
+		}
+
+		// Subnets are listed in the order of their "a.b.c." text
+		std::sort(out.subnets.begin(), out.subnets.end(),
+			[](const SubnetBits& a, const SubnetBits& b) {
+				return subnet_text_less(a.subnet, b.subnet);
+			});
 
-				++i;
+		// For each subnet, read off the runs of set bits
+		for (const SubnetBits& bits : out.subnets)
+		{
+			for (int start = next_host(bits, 0, true); start < 256; )
+			{
+				const int end = next_host(bits, start, false);
+				out.ranges.push_back({ bits.subnet | static_cast<std::uint32_t>(start),
+									   bits.subnet | static_cast<std::uint32_t>(end - 1) });
+				start = next_host(bits, end, true);
 			}
 		}
-		return results;
 	}
-	
-	// Split a CSV line into columns (simple, no quotes handling)
-	// e.g. "a,b,c" -> {"a","b","c"}
-	std::vector<std::wstring> split_csv_line(const std::wstring& line)
+
+	// Write one driver's CSV rows (a driver without nodes gets one row with an empty Range)
+	void write_driver_rows(		CSV::Writer& out,
+								const EthDriver& driver,
+								DriverRanges& ranges)
 	{
-		std::vector<std::wstring> cols;
-		std::wstring current;
+		nodes_to_ranges(driver, ranges);
 
-		for (wchar_t ch : line)
+		auto row_prefix = [&]() {
+			out.text(std::string_view("AB_ETH,"));
+			out.text(std::wstring_view(driver.name));
+			out.separator();
+			};
+
+		if (ranges.other.empty() && ranges.ranges.empty())
 		{
-			if (ch == L',')
-			{
-				trim(current);
-				cols.push_back(current);
-				current.clear();
-			}
-			else
-			{
-				current.push_back(ch);
-			}
+			row_prefix();
+			out.end_row();
+			return;
+		}
+
+		for (const std::wstring& text : ranges.other)
+		{
+			row_prefix();
+			out.text(std::wstring_view(text));
+			out.end_row();
 		}
 
-		trim(current);
-		cols.push_back(current);
-		return cols;
+		for (const IPv4::Range& range : ranges.ranges)
+		{
+			row_prefix();
+			out.range(range);
+			out.end_row();
+		}
 	}
+	
+	using CSV::Encoding::Kind;
+
+	using Diagnostics::Code;
+
+	// Format error found while tokenizing a data line. Line is relative to
+	// the chunk start; text points into the mapped file and is only
+	// widened when recorded.
+	struct RowError
+	{
+		std::size_t			line = 0;
+		Code				code = Code::ColumnCount;
+		std::uint8_t		column = Diagnostics::COLUMN_NONE;
+		std::string_view	text;
+	};
 
-	// Very simple IPv4 validator: "a.b.c.d" with octets 0–255
-	bool is_valid_ipv4(const std::wstring& ip_addr)
+	inline bool is_utf16(Kind kind) noexcept
 	{
-		std::wstring ip_str = ip_addr;
-		trim(ip_str);
-		
-		// Empty string check
-		if (ip_str.empty())
-			return false;	// Empty string is not valid
+		return kind == Kind::UTF16LE || kind == Kind::UTF16BE;
+	}
 
-		std::vector<std::wstring> ip_octets;
-		std::wstring curr_octet;
+	// Strip the BOM and transcode UTF-16 to UTF-8 (into transcoded).
+	// kind receives the encoding of the returned text. With keep_utf16,
+	// UTF-16 is returned as is for the caller to transcode piecewise.
+	std::string_view decode_text(	std::string_view raw,
+									std::string& transcoded,
+									Kind& kind,
+									bool keep_utf16 = false)
+	{
+		const CSV::Encoding::Detected encoding = CSV::Encoding::detect(raw);
+		raw.remove_prefix(encoding.bom_size);
 
-		// Split by '.' and collect octets
-		for (wchar_t ch : ip_str)
+		kind = encoding.kind;
+		if (is_utf16(kind) && !keep_utf16)
 		{
-			if (ch == L'.')
-			{
-				if (curr_octet.empty())
-					return false;
-				ip_octets.push_back(curr_octet);
-				curr_octet.clear();
-			}
-			else
-			{
-				curr_octet.push_back(ch);
-			}
+			CSV::Encoding::utf16_to_utf8(raw, kind == Kind::UTF16BE, transcoded);
+			kind = Kind::UTF8;
+			return transcoded;
 		}
+		return raw;
+	}
 
-		if (curr_octet.empty())
+	// One validated data line, still pointing into the mapped file
+	struct CsvRow
+	{
+		std::size_t			line = 0;		// relative to the chunk start
+		std::string_view	name;
+		IPv4::Range			nodes;			// a single address has first == last
+	};
+
+	// Everything one worker learns about one line-aligned slice of the file
+	struct ChunkResult
+	{
+		std::vector<CsvRow>		rows;
+		std::size_t				line_count = 0;
+		std::vector<RowError>	errors;			// in line order
+	};
+
+	// Validate the columns of one data line. Returns false and fills error on a format problem.
+	bool check_row(				const std::string_view* cols,
+								std::size_t count,
+								Kind kind,
+								CsvRow& row,
+								RowError& error)
+	{
+		auto fail = [&](Code code, std::uint8_t column, std::string_view text = {}) {
+			error.code = code;
+			error.column = column;
+			error.text = text;
 			return false;
+			};
 
-		ip_octets.push_back(curr_octet);
+		if (count < 3)
+			return fail(Code::ColumnCount, Diagnostics::COLUMN_NONE);
 
-		if (ip_octets.size() != 4)
-			return false;
+		row.name = cols[1];
+		const std::string_view range = cols[2];
+
+		// Type must be AB_ETH (for now)
+		if (cols[0] != "AB_ETH")
+			return fail(Code::UnsupportedType, Diagnostics::COLUMN_TYPE, cols[0]);
+
+		// Name: non-empty, <= 15 chars (RSLinx limit)
+		if (row.name.empty())
+			return fail(Code::EmptyName, Diagnostics::COLUMN_NAME);
 
-		try
+		if (CSV::Encoding::wide_length(row.name, kind) > DriverName::CAPACITY)
+			return fail(Code::NameTooLong, Diagnostics::COLUMN_NAME, row.name);
+
+		// Range must be either a single IP or an IP range
+		if (range.empty())
+			return fail(Code::EmptyRange, Diagnostics::COLUMN_RANGE);
+
+		if (IPv4::is_range(range))
 		{
-			for (const auto& part : ip_octets)
-			{
-				if (part.empty())
-					return false;
+			const IPv4::ParseError parse_error = IPv4::parse_range(range, row.nodes);
+			if (parse_error == IPv4::ParseError::BadRange)
+				return fail(Code::BadRange, Diagnostics::COLUMN_RANGE, range);
 
-				int n = std::stoi(part);
-				if (n < 0 || n > 255)
-					return false;
-			}
+			// The "x-y" part was fine, so the a.b.c base is what failed
+			if (parse_error != IPv4::ParseError::None)
+				return fail(Code::BadRangeAddress, Diagnostics::COLUMN_RANGE, CSV::trim_view(range.substr(0, range.find('-'))));
 		}
-		catch (...)
+		else if (IPv4::parse_address(range, row.nodes.first) != IPv4::ParseError::None)
 		{
-			return false;
+			// Treat as a single IP
+			return fail(Code::BadAddress, Diagnostics::COLUMN_RANGE, range);
+		}
+		else
+		{
+			row.nodes.last = row.nodes.first;
 		}
+
 		return true;
 	}
 
+	/*	-----------------------------------------------------------------
+		Function: parse_chunk
 
-	// Returns true if line_item looks like: "a.b.c.start-end"
-	bool has_ip_range(const std::wstring& line_item)
-	{
-		return line_item.find(L'-') != std::wstring::npos;
-	}
-
-	// Expand "a.b.c.start-end" into individual IP addresses.
-	// On any error (bad syntax, bad numbers, end < start, etc.) return an empty vector.
-	std::vector<std::wstring> expand_ip_range(const std::wstring& line_item)
-	{
-		std::wstring s = line_item;
-		trim(s);
-		if (s.empty())
-			return {};
+		Desc: Tokenizes and validates one line-aligned slice of the file.
+			  Has no shared state, so slices can run on separate threads.
 
-		// Find last '.' to separate base from last octet + range
-		std::size_t last_dot = s.find_last_of(L'.');
-		if (last_dot == std::wstring::npos)
-			return {}; // not a valid IP format
+			  Bad lines are recorded and skipped; the slice stops once
+			  max_errors format errors are found.
 
-		std::wstring base = s.substr(0, last_dot + 1);   // includes trailing '.'
-		std::wstring tail = s.substr(last_dot + 1);      // e.g. "10-20" or "10"
+			  Rows are only kept when keep_rows is set (build mode).
+		-----------------------------------------------------------------
+	*/
+	void parse_chunk(			std::string_view data,
+								Kind kind,
+								bool keep_rows,
+								std::size_t max_errors,
+								ChunkResult& result)
+	{
+		CSV::Tokenizer tokenizer(data);
+		std::string_view cols[3];
 
-		trim(tail);
-		if (tail.empty())
-			return {}; // no last octet
+		for (std::size_t count; (count = tokenizer.next_row(cols, 3)) != 0; ++result.line_count)
+		{
+			// Allow completely blank lines
+			if (count == 1 && cols[0].empty())
+				continue;
 
-		// We only handle the "start-end" from here on 
-		std::size_t dash_pos = tail.find(L'-');
-		if (dash_pos == std::wstring::npos)
-			return {}; // No dash -> not a range
+			CsvRow row;
+			RowError error;
+			row.line = result.line_count;
 
-		std::wstring range_start = tail.substr(0, dash_pos);
-		std::wstring range_end = tail.substr(dash_pos + 1);
+			if (!check_row(cols, count, kind, row, error))
+			{
+				error.line = result.line_count;
+				result.errors.push_back(error);
+				if (result.errors.size() >= max_errors)
+				{
+					++result.line_count;
+					return;
+				}
+				continue;
+			}
 
-		trim(range_start);
-		trim(range_end);
+			if (keep_rows)
+				result.rows.push_back(row);
+		}
+	}
 
-		if (range_start.empty() || range_end.empty())
-			return {}; // Missing start or end range. ex: "192.168.1.-5" and "192.168.1.10-"
+	// Cut data into slices of roughly target bytes, each ending just after a '\n'
+	std::vector<std::string_view> split_into_chunks(std::string_view data, std::size_t target)
+	{
+		std::vector<std::string_view> chunks;
+		std::size_t pos = 0;
 
-		// Make sure both start and end are all digits
-		auto is_all_digits = [](const std::wstring& t) {
-			if (t.empty()) return false;
-			for (wchar_t ch : t)
+		while (pos < data.size())
+		{
+			std::size_t end = data.size();
+			if (data.size() - pos > target)
 			{
-				if (!iswdigit(ch))
-					return false;
+				const char* first = data.data() + pos + target;
+				const char* last = data.data() + data.size();
+				const char* newline = CSV::Scan::find_newline(first, last);
+				end = (newline == last) ? data.size() : static_cast<std::size_t>(newline - data.data()) + 1;
 			}
-			return true;
-			};
 
-		if (!is_all_digits(range_start) || !is_all_digits(range_end))
-			return {};	// Non-digit characters in range
+			chunks.push_back(data.substr(pos, end - pos));
+			pos = end;
+		}
 
-		int start = 0;
-		int end = 0;
+		return chunks;
+	}
 
-		try
-		{
-			start = std::stoi(range_start);
-			end = std::stoi(range_end);
-		}
-		catch (...)
+	// Byte offset just past the first '\n' code unit at or after pos (even), or data.size()
+	std::size_t utf16_line_end(std::string_view data, bool big_endian, std::size_t pos) noexcept
+	{
+		const std::size_t low = big_endian ? 1 : 0;		// byte holding the '\n'
+		for (; pos + 1 < data.size(); pos += 2)
 		{
-			return {};
+			if (data[pos + low] == '\n' && data[pos + (1 - low)] == '\0')
+				return pos + 2;
 		}
+		return data.size();
+	}
 
-		// Octet range must be 0–255 and end >= start
-		if (start < 0 || start > 255 || end < 0 || end > 255 || end < start)
-			return{}; // This catches the a.b.c.d-e case where d > e and where d or e > 255
+	// split_into_chunks for UTF-16 text: slices of about target bytes, each
+	// ending just after a '\n' code unit, so each transcodes on its own
+	std::vector<std::string_view> split_utf16_into_chunks(std::string_view data, bool big_endian, std::size_t target)
+	{
+		target &= ~std::size_t(1);
 
-		// Finally, build the list of IPs
-		std::vector<std::wstring> ips;
-		ips.reserve(static_cast<std::size_t>(end - start + 1));	// Using reserve for memory allocation efficiency
+		std::vector<std::string_view> chunks;
+		std::size_t pos = 0;
 
-		for (int i = start; i <= end; ++i)
+		while (pos < data.size())
 		{
-			std::wstringstream ws;
-			ws << base << i;
-			ips.push_back(ws.str());
+			const std::size_t end = (data.size() - pos > target)
+				? utf16_line_end(data, big_endian, pos + target)
+				: data.size();
+
+			chunks.push_back(data.substr(pos, end - pos));
+			pos = end;
 		}
-		return ips;
+
+		return chunks;
 	}
-	
-}	// namespace
 
-namespace CSV 
-{
-	/*	-----------------------------------------------------------------
-		Function: read_drivers_from_file
+	// Fixed-size records for one cached row / error; offsets are relative to the chunk
+	struct CachedRow
+	{
+		std::uint32_t	line;
+		std::uint32_t	name_offset;
+		std::uint32_t	name_length;
+		std::uint32_t	first;
+		std::uint32_t	last;
+	};
+
+	struct CachedError
+	{
+		std::uint32_t	line;
+		std::uint32_t	text_offset;
+		std::uint32_t	text_length;
+		std::uint8_t	code;
+		std::uint8_t	column;
+		std::uint8_t	padding[2];
+	};
+
+	struct CachedChunk
+	{
+		std::uint64_t	line_count;
+		std::uint64_t	row_count;
+		std::uint64_t	error_count;
+	};
 
-		Desc: Reads ETH drivers from a CSV file into EthDriver structs
+	// Bump when ChunkResult, the row checks, or the blob layout change
+	constexpr std::uint64_t CHUNK_FORMAT = 2;
+	constexpr std::size_t MAX_CACHE_ENTRIES = 1024;
 
-		Format: Type,Name,Range
-		Example: AB_ETH,FL-IRVING, 192.168.2-90
-		-----------------------------------------------------------------
-	*/
-	bool read_drivers_from_file(	const std::wstring& path,
-									std::vector<EthDriver>& drivers_out,
-									std::wstring& error_message)
+	inline std::uint32_t offset_in(std::string_view chunk, std::string_view slice) noexcept
 	{
-		drivers_out.clear();
-		error_message.clear();
+		return slice.empty() ? 0 : static_cast<std::uint32_t>(slice.data() - chunk.data());
+	}
 
-		// 1. Validate structure first
-		if (!validate_csv_format(path, error_message))
-			return false;
+	// Serialize a parsed chunk. Slices are stored as offsets into the chunk,
+	// which stay valid for any chunk with the same bytes.
+	std::string encode_chunk(const ChunkResult& result, std::string_view chunk)
+	{
+		CachedChunk header = {};
+		header.line_count = result.line_count;
+		header.row_count = result.rows.size();
+		header.error_count = result.errors.size();
+
+		std::string blob(sizeof(header) +
+			result.errors.size() * sizeof(CachedError) +
+			result.rows.size() * sizeof(CachedRow), '\0');
+		std::memcpy(&blob[0], &header, sizeof(header));
+
+		char* out = &blob[sizeof(header)];
+		for (const RowError& error : result.errors)
+		{
+			CachedError cached = {};
+			cached.line = static_cast<std::uint32_t>(error.line);
+			cached.text_offset = offset_in(chunk, error.text);
+			cached.text_length = static_cast<std::uint32_t>(error.text.size());
+			cached.code = static_cast<std::uint8_t>(error.code);
+			cached.column = error.column;
+			std::memcpy(out, &cached, sizeof(cached));
+			out += sizeof(cached);
+		}
 
-		std::wifstream file(path);
-		if (!file.is_open())
+		for (const CsvRow& row : result.rows)
 		{
-			error_message = L"Failed to open CSV file: " + path;
-			return false;
+			const CachedRow cached = {
+				static_cast<std::uint32_t>(row.line),
+				offset_in(chunk, row.name),
+				static_cast<std::uint32_t>(row.name.size()),
+				row.nodes.first,
+				row.nodes.last };
+			std::memcpy(out, &cached, sizeof(cached));
+			out += sizeof(cached);
 		}
 
-		std::wstring line;
+		return blob;
+	}
+
+	// Rebuild a ChunkResult from encode_chunk output. False if the blob does not fit the chunk.
+	bool decode_chunk(const std::string& blob, std::string_view chunk, ChunkResult& result)
+	{
+		CachedChunk header = {};
+		if (blob.size() < sizeof(header))
+			return false;
+		std::memcpy(&header, blob.data(), sizeof(header));
 
-		// Skip header
-		if (!std::getline(file, line))
+		if (header.row_count > blob.size() || header.error_count > blob.size() ||
+			blob.size() != sizeof(header) + header.error_count * sizeof(CachedError) + header.row_count * sizeof(CachedRow))
 		{
-			error_message = L"CSV file is empty after header.";
 			return false;
 		}
 
-		std::size_t line_num = 2;   // data starts at line 2
+		result = ChunkResult();
+		result.line_count = static_cast<std::size_t>(header.line_count);
 
-		// Per-driver sets of IPs we've already seen. Used for duplicate detection.
-		std::unordered_map<std::wstring, std::unordered_set<std::wstring>> seen_nodes;
-
-		while (std::getline(file, line))
+		const char* in = blob.data() + sizeof(header);
+		result.errors.resize(static_cast<std::size_t>(header.error_count));
+		for (RowError& error : result.errors)
 		{
-			std::wstring tmp = line;
-			trim(tmp);
-			if (tmp.empty())
-			{
-				++line_num;
-				continue;
-			}
+			CachedError cached;
+			std::memcpy(&cached, in, sizeof(cached));
+			in += sizeof(cached);
 
-			auto cols = split_csv_line(line);
-			if (cols.size() < 3)
+			if (std::uint64_t(cached.text_offset) + cached.text_length > chunk.size() ||
+				cached.code > static_cast<std::uint8_t>(Code::BadAddress))
 			{
-				error_message = L"Line " + std::to_wstring(line_num) +
-								L": expected 3 columns (Type,Name,Range).";
 				return false;
 			}
 
-			std::wstring type = cols[0];
-			std::wstring name = cols[1];
-			std::wstring range = cols[2];
+			error.line = cached.line;
+			error.code = static_cast<Code>(cached.code);
+			error.column = cached.column;
+			error.text = chunk.substr(cached.text_offset, cached.text_length);
+		}
 
-			trim(type);
-			trim(name);
-			trim(range);
+		result.rows.resize(static_cast<std::size_t>(header.row_count));
+		for (CsvRow& row : result.rows)
+		{
+			CachedRow cached;
+			std::memcpy(&cached, in, sizeof(cached));
+			in += sizeof(cached);
 
-			if (type != L"AB_ETH")
-			{
-				error_message = L"Line " + std::to_wstring(line_num) +
-								L": unsupported Type \"" + type + L"\".";
+			if (std::uint64_t(cached.name_offset) + cached.name_length > chunk.size())
 				return false;
-			}
 
-			if (name.empty())
-			{
-				error_message = L"Line " + std::to_wstring(line_num) +
-								L": Name field is empty.";
-				return false;
-			}
+			row.line = cached.line;
+			row.name = chunk.substr(cached.name_offset, cached.name_length);
+			row.nodes.first = cached.first;
+			row.nodes.last = cached.last;
+		}
 
-			// Find or create driver
-			EthDriver* driver_ptr = nullptr;
+		return true;
+	}
+
+	// parse_chunk, going through the chunk cache when one is enabled
+	void process_chunk(			std::string_view chunk,
+								Kind kind,
+								bool keep_rows,
+								std::size_t max_errors,
+								const CSV::ChunkCache& cache,
+								ChunkResult& result)
+	{
+		if (!cache.is_enabled())
+		{
+			parse_chunk(chunk, kind, keep_rows, max_errors, result);
+			return;
+		}
+
+		// The name length check depends on the encoding and the error cap
+		// decides where a bad chunk stops, so both are part of the key
+		const std::uint64_t seed = (CHUNK_FORMAT << 56) ^ (std::uint64_t(max_errors) << 8) ^ static_cast<std::uint64_t>(kind);
+		const std::uint64_t key = CSV::hash_bytes(chunk, seed);
+
+		std::string blob;
+		if (cache.load(key, chunk, blob) && decode_chunk(blob, chunk, result))
+			return;
+
+		result = ChunkResult();
+		parse_chunk(chunk, kind, true, max_errors, result);
+		cache.store(key, chunk, encode_chunk(result, chunk));
+	}
+
+
+	/*	-----------------------------------------------------------------
+		Class: DriverBuilder
 
-			auto it = std::find_if(
-				drivers_out.begin(), drivers_out.end(),
-				[&](const EthDriver& d) { return d.name == name; });
+		Desc: Applies validated rows to the driver list in file order.
 
-			if (it == drivers_out.end())
+			  Ranges stay as intervals: duplicates and overlaps are found
+			  on a 256-bit host bitmap per (driver, /24 subnet), and
+			  drivers are found through a hash index on the name slice.
+			  Node strings are only created in finish(), so ingest is
+			  linear in file size.
+
+			  Duplicate and 254-node errors are reported at the same
+			  address and line the per-address loop used to stop at.
+
+			  The index and per-driver state are scratch, allocated
+			  from memory; only the EthDriver list outlives the builder.
+		-----------------------------------------------------------------
+	*/
+	class DriverBuilder
+	{
+	public:
+		// Keys point into the row names, so the text must outlive the builder
+		static constexpr bool COPIES_ROWS = false;
+
+		DriverBuilder(std::vector<EthDriver>& drivers_out, std::pmr::memory_resource* memory)
+			: m_drivers(drivers_out)
+			, m_memory(memory)
+			, m_state(memory)
+			, m_index(memory)
+		{}
+
+		// Encoding of the name slices passed to apply()
+		void set_kind(Kind kind) { m_kind = kind; }
+
+		// Returns false and records a diagnostic if the row cannot be added.
+		// The row is then skipped and later rows can still be applied.
+		bool apply(const CsvRow& row, std::size_t line_num, Diagnostics::List& diagnostics)
+		{
+			// Find or create driver
+			auto found = m_index.find(row.name);
+			if (found == m_index.end())
 			{
 				EthDriver d{};
-				d.key_name = L"";
-				d.name = name;
+				d.key_name.clear();
+				d.name = DriverName(CSV::Encoding::to_wide(row.name, m_kind));		// check_row kept it within 15
 				d.station = 63;
 				d.ping_timeout = 0;
 				d.inactivity_timeout = 0;
 				d.startup = 0;
 				d.nodes.clear();
 
-				drivers_out.push_back(std::move(d));
-				driver_ptr = &drivers_out.back();
-			}
-			else
-			{
-				driver_ptr = &(*it);
+				m_drivers.push_back(std::move(d));
+				m_state.emplace_back(m_memory);
+				found = m_index.emplace(row.name, m_drivers.size() - 1).first;
 			}
 
-			// Ensure we have a set for this driver name
-			auto& set_ref = seen_nodes[name]; // creates empty set if not present
+			const std::size_t driver_index = found->second;
+			DriverState& state = m_state[driver_index];
 
-			// Expand range -> IPs
-			std::vector<std::wstring> ips;
-			if (has_ip_range(range))
-			{
-				ips = expand_ip_range(range);
-				if (ips.empty())
-				{
-					error_message = L"Line " + std::to_wstring(line_num) +
-									L": range \"" + range +
-									L"\" did not yield any addresses.";
-					return false;
-				}
-			}
-			else
+			// Interval of hosts this row adds within one /24
+			const std::uint32_t subnet = row.nodes.first >> 8;
+			const int lo = static_cast<int>(row.nodes.first & 0xFF);
+			const int hi = static_cast<int>(row.nodes.last & 0xFF);
+
+			SubnetBits& bits = subnet_bits(state, subnet);
+
+			// Address index (from lo) where the old per-address loop would stop:
+			// the first duplicate, or the first address past the 254-node limit.
+			const int count = hi - lo + 1;
+			const int duplicate_at = first_set(bits, lo, hi);
+			const int room = static_cast<int>(MAX_NODES - state.node_count);
+
+			if (duplicate_at < count && duplicate_at <= room)
 			{
-				ips.push_back(range);
+				diagnostics.add(Code::DuplicateNode, static_cast<std::uint32_t>(line_num), Diagnostics::COLUMN_RANGE,
+					m_drivers[driver_index].name, {}, row.nodes.first + static_cast<std::uint32_t>(duplicate_at));
+				return false;
 			}
 
-			// Append IPs, enforcing 254-node limit and duplicate check
-			for (const auto& ip_raw : ips)
+			if (room < count)
 			{
-				std::wstring ip = ip_raw;
-				trim(ip);
-
-				// Duplicate check (per driver)
-				if (set_ref.find(ip) != set_ref.end())
+				// Reported once per driver; its later rows cannot fit either
+				if (!state.limit_reported)
 				{
-					error_message = L"Line " + std::to_wstring(line_num) +
-									L": duplicate node IP \"" + ip +
-									L"\" for driver \"" + name + L"\".";
-					return false;
+					state.limit_reported = true;
+					diagnostics.add(Code::NodeLimit, static_cast<std::uint32_t>(line_num), Diagnostics::COLUMN_RANGE,
+						m_drivers[driver_index].name);
 				}
+				return false;
+			}
+
+			set_bits(bits, lo, hi);
+			state.node_count += static_cast<std::size_t>(count);
+			state.runs.push_back(row.nodes);
+			return true;
+		}
 
-				if (driver_ptr->nodes.size() >= 254)
+		// Expand the collected intervals into EthDriver::nodes, in file order
+		// (apply() has already kept each driver within MAX_NODES)
+		bool finish(Diagnostics::List&)
+		{
+			for (std::size_t i = 0; i < m_drivers.size(); ++i)
+			{
+				NodeList& nodes = m_drivers[i].nodes;
+				for (const IPv4::Range& run : m_state[i].runs)
 				{
-					error_message =
-						L"Driver \"" + name +
-						L"\" exceeds maximum of 254 nodes. "
-						L"Limit reached while processing line " +
-						std::to_wstring(line_num) + L".";
-					return false;
+					// Stop on the last address rather than past it: a run ending at
+					// 255.255.255.255 would wrap and never end
+					for (std::uint32_t address = run.first; ; ++address)
+					{
+						nodes.push_back(address);
+						if (address == run.last) break;
+					}
 				}
-
-				driver_ptr->nodes.push_back(ip);
-				set_ref.insert(ip);
 			}
-
-			++line_num;
+			return true;
 		}
 
-		return true;
-	}
-
-	/*	-----------------------------------------------------------------
-		Function: write_drivers_to_file
-
-		Desc: Writes existing ETH drivers to a CSV file
-		-----------------------------------------------------------------
-	*/
-	bool write_drivers_to_file(		const std::wstring& path,
-									const std::vector<EthDriver>& drivers_in,
-									std::wstring& error_message)
-	{
-		
-		error_message.clear();
-
-		std::wofstream file(path);
-		if (!file.is_open())
+		// Forget every driver so the builder can take the next batch
+		void reset()
 		{
-			error_message = L"Failed to open file for writing: " + path;
-			return false;
+			m_drivers.clear();
+			m_state.clear();
+			m_index.clear();
 		}
 
-		//CSV Header
-		file << L"Type,Name,Range\n";
-		for (const auto& driver : drivers_in)
-		{
-			auto ranges = nodes_to_ranges(driver.nodes);
+	private:
+		static constexpr std::size_t MAX_NODES = NodeList::CAPACITY;
 
-			if (ranges.empty())
+		struct DriverState
+		{
+			explicit DriverState(std::pmr::memory_resource* memory)
+				: subnets(memory)
+				, runs(memory)
+			{}
+
+			std::size_t						node_count = 0;
+			bool							limit_reported = false;
+			std::pmr::vector<SubnetBits>	subnets;		// at most a handful per driver
+			std::pmr::vector<IPv4::Range>	runs;			// in file order
+		};
+
+		static SubnetBits& subnet_bits(DriverState& state, std::uint32_t subnet)
+		{
+			for (SubnetBits& bits : state.subnets)
 			{
-				file << L"AB_ETH," << driver.name << L"," << L"" << L"\n";
-				continue;
+				if (bits.subnet == subnet)
+					return bits;
 			}
 
-			for (const auto& r : ranges)
+			state.subnets.emplace_back();
+			state.subnets.back().subnet = subnet;
+			return state.subnets.back();
+		}
+
+		// Offset from lo of the first used host in lo..hi, or hi - lo + 1 if none
+		static int first_set(const SubnetBits& bits, int lo, int hi) noexcept
+		{
+			for (int word = lo >> 6; word <= (hi >> 6); ++word)
 			{
-				file << L"AB_ETH," << driver.name << L"," << r << L"\n";
+				const int from = (word == (lo >> 6)) ? (lo & 63) : 0;
+				const int to = (word == (hi >> 6)) ? (hi & 63) : 63;
+
+				const std::uint64_t hit = bits.words[word] & word_mask(from, to);
+				if (hit != 0)
+					return word * 64 + static_cast<int>(lowest_bit64(hit)) - lo;
 			}
-			
+			return hi - lo + 1;
 		}
 
-		if (!file.good())
+		static void set_bits(SubnetBits& bits, int lo, int hi) noexcept
 		{
-			error_message = L"Error occurred while writing to file: " + path;
-			return false;
+			for (int word = lo >> 6; word <= (hi >> 6); ++word)
+			{
+				const int from = (word == (lo >> 6)) ? (lo & 63) : 0;
+				const int to = (word == (hi >> 6)) ? (hi & 63) : 63;
+				bits.words[word] |= word_mask(from, to);
+			}
 		}
 
-		return true;
-		
-	}
+		std::vector<EthDriver>&									m_drivers;
+		Kind													m_kind = Kind::UTF8;
+		std::pmr::memory_resource*								m_memory;
+		std::pmr::vector<DriverState>							m_state;		// parallel to m_drivers
+		std::pmr::unordered_map<std::string_view, std::size_t>	m_index;		// name slice -> driver index
+	};
 
-	/*	-----------------------------------------------------------------
-		Function: validate_csv_format
+	// Files below this size are parsed as a single chunk on the calling thread
+	constexpr std::size_t MIN_CHUNK_BYTES = std::size_t(1) << 20;		// 1 MB
+	constexpr std::size_t NO_CHUNK_LIMIT = static_cast<std::size_t>(-1);
 
-		Desc: Validation to check the CSV file format is correct
+	// Smallest memory budget stream_drivers_from_file will work with
+	constexpr std::size_t MIN_STREAM_BUDGET = std::size_t(4) << 20;		// 4 MB
+
+	enum class ScanMode
+	{
+		FirstError,		// stop at the first format error; build errors only if there is none
+		AllErrors		// record every problem, in line order, until the list is full
+	};
+
+	/*	-----------------------------------------------------------------
+		Function: scan_csv_file
+
+		Desc: Single pass over a memory-mapped CSV file shared by
+			  validate_csv_format, read_drivers_from_file and
+			  stream_drivers_from_file.
+
+			  Every line is validated; when sink is non-null the same
+			  pass also feeds each row, in file order, to sink->apply()
+			  and calls sink->finish() at the end. Passing nullptr gives
+			  the validate-only mode.
+
+			  Problems are added to diagnostics. Returns true if none
+			  were found.
+
+			  Chunks are at most max_chunk_bytes (give or take a line),
+			  which bounds the rows held in flight.
+
+			  UTF-8 and UTF-16 files (with or without a BOM) are read
+			  as such; anything else is taken one byte per character.
+			  UTF-16 is parsed as UTF-8. A sink that keeps pointing
+			  into the text (Sink::COPIES_ROWS is false) needs the
+			  whole file transcoded up front; otherwise each chunk is
+			  transcoded as it is parsed and released once applied, so
+			  only the chunks in flight exist in UTF-8.
+
+			  With ReadOptions::cache_dir set, chunk boundaries are
+			  content-defined and each chunk's result is cached on disk
+			  under a hash of its bytes, so re-importing an edited file
+			  only re-parses the chunks that changed.
+
+			  Large files are cut into line-aligned chunks that worker
+			  threads tokenize and validate independently. Results are
+			  applied in file order on the calling thread, so drivers,
+			  node order, and the reported errors (and their line
+			  numbers) match a serial parse.
+
+			  In FirstError mode, format errors take priority over sink
+			  errors (duplicate node, 254-node limit), so a file that has
+			  both reports the same message as validating and then
+			  reading it. In AllErrors mode bad rows are skipped and
+			  every problem is recorded until diagnostics is full.
 		-----------------------------------------------------------------
 	*/
-	bool validate_csv_format(		const std::wstring& path,
-									std::wstring& error_message)
+	template <typename Sink>
+	bool scan_csv_file(			const std::wstring& path,
+								Sink* sink,
+								Diagnostics::List& diagnostics,
+								const CSV::ReadOptions& options,
+								std::size_t max_chunk_bytes,
+								ScanMode mode)
 	{
-		error_message.clear();
+		const std::size_t first_diagnostic = diagnostics.size();
 
-		std::wifstream file(path);
-		if (!file.is_open())
+		MappedFile file;
+		if (file.Open(path) != ERROR_SUCCESS)
 		{
-			error_message = L"Failed to open CSV file: " + path;
+			diagnostics.add(Code::OpenFailed, 0, Diagnostics::COLUMN_NONE, {}, path);
 			return false;
 		}
 
-		std::wstring line;
+		// ---- Detect the encoding; UTF-16 is transcoded to UTF-8 ----
+		const bool per_chunk = (sink == nullptr || Sink::COPIES_ROWS);
+		std::string transcoded;
+		Kind kind = Kind::UTF8;
+		const std::string_view text = decode_text(file.View(), transcoded, kind, per_chunk);
+
+		const bool chunked_utf16 = is_utf16(kind);
+		const bool big_endian = (kind == Kind::UTF16BE);
+		if (chunked_utf16)
+			kind = Kind::UTF8;			// what the chunks are parsed as
+
+		// The header line on its own, in UTF-8
+		std::string header_text;
+		std::size_t header_size = 0;
+		if (chunked_utf16)
+		{
+			header_size = utf16_line_end(text, big_endian, 0);
+			CSV::Encoding::utf16_to_utf8(text.substr(0, header_size), big_endian, header_text);
+		}
+
+		CSV::Tokenizer tokenizer(chunked_utf16 ? std::string_view(header_text) : text);
+		std::string_view cols[3];
 
 		// ---- Check header ----
-		if (!std::getline(file, line))
+		const std::size_t header_count = tokenizer.next_row(cols, 3);
+		if (header_count == 0)
 		{
-			error_message = L"CSV file is empty.";
+			diagnostics.add(Code::EmptyFile);
 			return false;
 		}
 
-		auto header_cols = split_csv_line(line);
-		if (header_cols.size() < 3)
+		if (header_count < 3)
 		{
-			error_message = L"CSV header is invalid. Expected: Type,Name,Range";
+			diagnostics.add(Code::HeaderColumns, 1);
 			return false;
 		}
 
-		if (header_cols[0] != L"Type" ||
-			header_cols[1] != L"Name" ||
-			header_cols[2] != L"Range")
+		if (cols[0] != "Type" ||
+			cols[1] != "Name" ||
+			cols[2] != "Range")
 		{
-			error_message = L"CSV header must be: Type,Name,Range";
+			diagnostics.add(Code::HeaderNames, 1);
 			return false;
 		}
 
-		// ---- Validate each data line ----
-		std::size_t line_num = 2;   // data starts at line 2
+		// ---- Split the data lines into chunks ----
+		const std::string_view data = text.substr(chunked_utf16 ? header_size : tokenizer.position());
+
+		unsigned threads = options.threads;
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+
+		// A few chunks per thread keeps the workers balanced. With a cache,
+		// boundaries follow the content so unchanged rows map to the same chunks
+		// (except for UTF-16 transcoded per chunk, which is cut by size).
+		const CSV::ChunkCache cache(options.cache_dir);
+		const std::size_t target = std::min(max_chunk_bytes,
+			std::max(MIN_CHUNK_BYTES, data.size() / (std::size_t(threads) * 4)));
+		const std::vector<std::string_view> chunks = chunked_utf16
+			? split_utf16_into_chunks(data, big_endian, target)
+			: cache.is_enabled()
+			? CSV::split_content_defined(data)
+			: split_into_chunks(data, target);
+
+		// UTF-8 text of each UTF-16 chunk, from when it is parsed until it is applied
+		std::vector<std::string> chunk_text(chunked_utf16 ? chunks.size() : 0);
+		auto chunk_utf8 = [&](std::size_t index) -> std::string_view {
+			if (!chunked_utf16)
+				return chunks[index];
+			CSV::Encoding::utf16_to_utf8(chunks[index], big_endian, chunk_text[index]);
+			return chunk_text[index];
+			};
 
-		while (std::getline(file, line))
-		{
-			// Allow completely blank lines
-			std::wstring tmp = line;
-			trim(tmp);
-			if (tmp.empty())
+		const bool build = (sink != nullptr);
+		if (build)
+			sink->set_kind(kind);
+
+		const bool first_error = (mode == ScanMode::FirstError);
+		const std::size_t max_errors = first_error ? 1 : diagnostics.limit();
+		std::vector<ChunkResult> results(chunks.size());
+
+		// ---- Tokenize and validate on worker threads ----
+		// Workers stay at most a few chunks ahead of the in-order consumer
+		// below so finished rows do not pile up in memory.
+		std::mutex mutex;
+		std::condition_variable cv;
+		std::vector<char> done(chunks.size(), 0);
+		std::size_t next_chunk = 0;
+		std::size_t consumed = 0;
+		bool stop = false;
+		const std::size_t window = std::size_t(threads) * 2;
+
+		auto worker = [&]() {
+			while (true)
 			{
-				++line_num;
-				continue;
-			}
+				std::size_t index = 0;
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					cv.wait(lock, [&] {
+						return stop || next_chunk >= chunks.size() || next_chunk < consumed + window;
+						});
+					if (stop || next_chunk >= chunks.size())
+						return;
+					index = next_chunk++;
+				}
 
-			auto cols = split_csv_line(line);
-			if (cols.size() < 3)
-			{
-				error_message = L"Line " + std::to_wstring(line_num) +
-								L": expected 3 columns (Type,Name,Range).";
-				return false;
+				process_chunk(chunk_utf8(index), kind, build, max_errors, cache, results[index]);
+
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					done[index] = 1;
+				}
+				cv.notify_all();
 			}
+			};
+
+		std::vector<std::thread> pool;
+		const std::size_t worker_count = std::min<std::size_t>(threads, chunks.size());
+		if (worker_count > 1)
+		{
+			pool.reserve(worker_count);
+			for (std::size_t i = 0; i < worker_count; ++i)
+				pool.emplace_back(worker);
+		}
 
-			std::wstring type = cols[0];
-			std::wstring name = cols[1];
-			std::wstring range = cols[2];
+		// ---- Apply chunks in file order ----
+		// In FirstError mode the first build error waits here and is only
+		// reported if no format error follows.
+		Diagnostics::List held(1);
+		Diagnostics::List& build_diagnostics = first_error ? held : diagnostics;
+		std::size_t line_base = 2;		// data starts at line 2
 
-			trim(type);
-			trim(name);
-			trim(range);
+		auto add_row_error = [&](const RowError& error) {
+			diagnostics.add(error.code, static_cast<std::uint32_t>(line_base + error.line), error.column,
+				{}, CSV::Encoding::to_wide(error.text, kind));
+			};
 
-			// Type must be AB_ETH (for now)
-			if (type != L"AB_ETH")
+		for (std::size_t index = 0; index < chunks.size(); ++index)
+		{
+			if (pool.empty())
 			{
-				error_message = L"Line " + std::to_wstring(line_num) +
-								L": unsupported Type \"" + type + L"\". "
-								L"Expected \"AB_ETH\".";
-				return false;
+				process_chunk(chunk_utf8(index), kind, build, max_errors, cache, results[index]);
+			}
+			else
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				cv.wait(lock, [&] { return done[index] != 0; });
 			}
 
-			// Name: non-empty, <= 15 chars (RSLinx limit)
-			if (name.empty())
+			ChunkResult& chunk = results[index];
+
+			// Rows and format errors are both in line order; interleave them
+			std::size_t next_error = 0;
+			for (const CsvRow& row : chunk.rows)
 			{
-				error_message = L"Line " + std::to_wstring(line_num) +
-								L": Name field is empty.";
-				return false;
+				if (!first_error)
+				{
+					while (next_error < chunk.errors.size() && chunk.errors[next_error].line < row.line)
+						add_row_error(chunk.errors[next_error++]);
+				}
+
+				if (build && (!first_error || held.empty()))
+					sink->apply(row, line_base + row.line, build_diagnostics);
 			}
 
-			if (name.length() > 15)
+			for (; next_error < chunk.errors.size(); ++next_error)
+				add_row_error(chunk.errors[next_error]);
+
+			const bool stop_here = first_error ? !chunk.errors.empty() : diagnostics.full();
+
+			line_base += chunk.line_count;
+			chunk = ChunkResult();		// release rows as soon as they are applied
+			if (chunked_utf16)
+				std::string().swap(chunk_text[index]);
+
+			if (stop_here)
+				break;
+
+			if (!pool.empty())
 			{
-				error_message = L"Line " + std::to_wstring(line_num) +
-								L": driver name \"" + name +
-								L"\" exceeds 15-character limit.";
-				return false;
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					consumed = index + 1;
+				}
+				cv.notify_all();
 			}
+		}
 
-			// Range must be either a single IP or an IP range
-			if (range.empty())
+		if (!pool.empty())
+		{
 			{
-				error_message = L"Line " + std::to_wstring(line_num) +
-								L": Range field is empty.";
+				std::lock_guard<std::mutex> lock(mutex);
+				stop = true;
+			}
+			cv.notify_all();
+			for (auto& t : pool)
+				t.join();
+		}
+
+		cache.trim(MAX_CACHE_ENTRIES);
+
+		if (first_error && diagnostics.size() == first_diagnostic && !held.empty())
+			diagnostics.add(held, 0);
+
+		if (diagnostics.size() != first_diagnostic)
+			return false;
+
+		return !build || sink->finish(diagnostics);
+	}
+
+	// One validated row as stored in a run file. Names are at most 15 UTF-16
+	// units, so 45 bytes of UTF-8 at most.
+	struct RunRecord
+	{
+		std::uint64_t	line;
+		std::uint32_t	first;
+		std::uint32_t	last;
+		std::uint8_t	name_length;
+		char			name[63];
+	};
+
+	static_assert(sizeof(RunRecord) == 80, "RunRecord is written to disk as-is");
+
+	// Order by name bytes, then by line, so each driver's rows come out in file order
+	bool run_record_less(const char* a, const char* b)
+	{
+		RunRecord ra;
+		RunRecord rb;
+		std::memcpy(&ra, a, sizeof(ra));
+		std::memcpy(&rb, b, sizeof(rb));
+
+		const int order = std::string_view(ra.name, ra.name_length).compare(std::string_view(rb.name, rb.name_length));
+		if (order != 0)
+			return order < 0;
+		return ra.line < rb.line;
+	}
+
+	/*	-----------------------------------------------------------------
+		Class: RunSink
+
+		Desc: scan_csv_file sink for the streaming import. Buffers rows
+			  up to a fixed count, then sorts them by driver name and
+			  writes them out as one run of the external sort.
+		-----------------------------------------------------------------
+	*/
+	class RunSink
+	{
+	public:
+		// Rows are copied into records, so the text can go once they are applied
+		static constexpr bool COPIES_ROWS = true;
+
+		RunSink(CSV::RunStore& store, std::size_t capacity)
+			: m_store(store)
+			, m_capacity(std::max<std::size_t>(1, capacity))
+		{
+			m_buffer.reserve(m_capacity);
+		}
+
+		void set_kind(Kind kind) { m_kind = kind; }
+		Kind kind() const { return m_kind; }
+
+		bool apply(const CsvRow& row, std::size_t line_num, Diagnostics::List& diagnostics)
+		{
+			RunRecord record = {};
+			record.line = line_num;
+			record.first = row.nodes.first;
+			record.last = row.nodes.last;
+			record.name_length = static_cast<std::uint8_t>(std::min(row.name.size(), sizeof(record.name)));
+			std::memcpy(record.name, row.name.data(), record.name_length);
+			m_buffer.push_back(record);
+
+			return m_buffer.size() < m_capacity || flush(diagnostics);
+		}
+
+		bool finish(Diagnostics::List& diagnostics) { return flush(diagnostics); }
+
+	private:
+		bool flush(Diagnostics::List& diagnostics)
+		{
+			std::sort(m_buffer.begin(), m_buffer.end(),
+				[](const RunRecord& a, const RunRecord& b) {
+					return run_record_less(reinterpret_cast<const char*>(&a), reinterpret_cast<const char*>(&b));
+				});
+
+			if (!m_store.add_run(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size()))
+			{
+				diagnostics.add(Code::TempWriteFailed);
 				return false;
 			}
 
-			if (has_ip_range(range))
+			m_buffer.clear();
+			return true;
+		}
+
+		CSV::RunStore&				m_store;
+		std::size_t					m_capacity;
+		std::vector<RunRecord>		m_buffer;
+		Kind						m_kind = Kind::UTF8;
+	};
+
+	// Drivers formatted per work item when exporting on several threads
+	constexpr std::size_t DRIVERS_PER_BATCH = 256;
+
+	/*	-----------------------------------------------------------------
+		Function: format_drivers
+
+		Desc: Formats the CSV rows of every driver on worker threads and
+			  hands the text to emit in driver order.
+
+			  Drivers are split into fixed batches; each worker formats
+			  a batch into its own in-memory Writer. Batches are emitted
+			  in order on the calling thread, so the output is byte for
+			  byte what a serial export produces. Workers stay at most a
+			  few batches ahead so formatted text does not pile up.
+		-----------------------------------------------------------------
+	*/
+	void format_drivers(		const std::vector<EthDriver>& drivers,
+								unsigned threads,
+								const std::function<void(std::string_view rows)>& emit)
+	{
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+
+		const std::size_t batches = (drivers.size() + DRIVERS_PER_BATCH - 1) / DRIVERS_PER_BATCH;
+		const std::size_t worker_count = std::min<std::size_t>(threads, batches);
+
+		auto format_batch = [&](std::size_t index, CSV::Writer& out) {
+			DriverRanges ranges;
+			const std::size_t first = index * DRIVERS_PER_BATCH;
+			const std::size_t last = std::min(first + DRIVERS_PER_BATCH, drivers.size());
+			for (std::size_t i = first; i < last; ++i)
+				write_driver_rows(out, drivers[i], ranges);
+			};
+
+		if (worker_count <= 1)
+		{
+			CSV::Writer out;
+			for (std::size_t index = 0; index < batches; ++index)
+			{
+				format_batch(index, out);
+				emit(out.buffered());
+				out.clear();
+			}
+			return;
+		}
+
+		std::mutex mutex;
+		std::condition_variable cv;
+		std::vector<std::unique_ptr<CSV::Writer>> results(batches);
+		std::size_t next_batch = 0;
+		std::size_t consumed = 0;
+		const std::size_t window = worker_count * 2;
+
+		auto worker = [&]() {
+			while (true)
 			{
-				// Expand and validate each IP
-				auto ips = expand_ip_range(range);
-				if (ips.empty())
+				std::size_t index = 0;
 				{
-					error_message = L"Line " + std::to_wstring(line_num) +
-									L": IP range \"" + range +
-									L"\" did not produce any addresses.";
-					return false;
+					std::unique_lock<std::mutex> lock(mutex);
+					cv.wait(lock, [&] {
+						return next_batch >= batches || next_batch < consumed + window;
+						});
+					if (next_batch >= batches)
+						return;
+					index = next_batch++;
 				}
 
-				for (const auto& ip : ips)
+				auto out = std::make_unique<CSV::Writer>(std::size_t(64) << 10);
+				format_batch(index, *out);
+
 				{
-					if (!is_valid_ipv4(ip))
+					std::lock_guard<std::mutex> lock(mutex);
+					results[index] = std::move(out);
+				}
+				cv.notify_all();
+			}
+			};
+
+		std::vector<std::thread> pool;
+		pool.reserve(worker_count);
+		for (std::size_t i = 0; i < worker_count; ++i)
+			pool.emplace_back(worker);
+
+		for (std::size_t index = 0; index < batches; ++index)
+		{
+			std::unique_ptr<CSV::Writer> out;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				cv.wait(lock, [&] { return results[index] != nullptr; });
+				out = std::move(results[index]);
+			}
+
+			emit(out->buffered());
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				consumed = index + 1;
+			}
+			cv.notify_all();
+		}
+
+		for (auto& t : pool)
+			t.join();
+	}
+
+	// Node limit for a driver assembled from several files
+	constexpr std::size_t MAX_COMBINED_NODES = NodeList::CAPACITY;
+
+	/*	-----------------------------------------------------------------
+		Function: split_threads
+
+		Desc: Shares the chunk-parsing threads between files in
+			  proportion to their size, at least one each, so the
+			  largest file - which bounds the total time - gets the
+			  most help.
+		-----------------------------------------------------------------
+	*/
+	std::vector<unsigned> split_threads(	const std::vector<std::wstring>& paths,
+											unsigned total)
+	{
+		if (total == 0)
+			total = std::max(1u, std::thread::hardware_concurrency());
+
+		std::vector<std::uintmax_t> sizes(paths.size(), 0);
+		std::uintmax_t sum = 0;
+		for (std::size_t i = 0; i < paths.size(); ++i)
+		{
+			std::error_code ec;
+			const std::uintmax_t size = std::filesystem::file_size(std::filesystem::path(paths[i]), ec);
+			sizes[i] = ec ? 0 : size;
+			sum += sizes[i];
+		}
+
+		std::vector<unsigned> threads(paths.size(), 1);
+		if (sum == 0)
+			return threads;
+
+		for (std::size_t i = 0; i < paths.size(); ++i)
+		{
+			const double share = static_cast<double>(sizes[i]) / static_cast<double>(sum);
+			threads[i] = std::max(1u, static_cast<unsigned>(share * total + 0.5));
+		}
+		return threads;
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: combine_drivers
+
+		Desc: Folds the drivers read from one file into the combined
+			  list. index maps driver names already in combined to
+			  their position, and origin records which file each came
+			  from (for conflict messages).
+		-----------------------------------------------------------------
+	*/
+	void combine_drivers(		std::vector<EthDriver>&& drivers,
+								std::size_t file,
+								const std::vector<std::wstring>& paths,
+								CSV::ConflictPolicy policy,
+								std::vector<EthDriver>& combined,
+								std::pmr::vector<std::size_t>& origin,
+								std::pmr::unordered_map<DriverName, std::size_t>& index,
+								Diagnostics::List& diagnostics)
+	{
+		for (EthDriver& driver : drivers)
+		{
+			const auto found = index.find(driver.name);
+			if (found == index.end())
+			{
+				index.emplace(driver.name, combined.size());
+				origin.push_back(file);
+				combined.push_back(std::move(driver));
+				continue;
+			}
+
+			EthDriver& existing = combined[found->second];
+			switch (policy)
+			{
+			case CSV::ConflictPolicy::FirstWins:
+				break;
+
+			case CSV::ConflictPolicy::Error:
+				diagnostics.add(Code::DuplicateDriver, 0, Diagnostics::COLUMN_NONE,
+					driver.name, paths[origin[found->second]], 0, paths[file]);
+				break;
+
+			case CSV::ConflictPolicy::UnionNodes:
+			{
+				bool over_limit = false;
+				for (const std::uint32_t node : driver.nodes)
+				{
+					if (existing.nodes.contains(node))
+						continue;
+
+					if (existing.nodes.size() >= MAX_COMBINED_NODES)
 					{
-						error_message = L"Line " + std::to_wstring(line_num) +
-										L": \"" + ip +
-										L"\" is not a valid IPv4 address.";
-						return false;
+						over_limit = true;
+						break;
 					}
+
+					existing.nodes.push_back(node);
+				}
+
+				if (over_limit)
+				{
+					diagnostics.add(Code::CombinedNodeLimit, 0, Diagnostics::COLUMN_NONE,
+						driver.name, {}, 0, paths[file]);
 				}
+				break;
+			}
+			}
+		}
+	}
+
+}	// namespace
+
+namespace CSV 
+{
+	/*	-----------------------------------------------------------------
+		Function: read_drivers_from_file
+
+		Desc: Reads ETH drivers from a CSV file into EthDriver structs.
+			  Validation and parsing happen in the same pass.
+
+		Format: Type,Name,Range
+		Example: AB_ETH,FL-IRVING, 192.168.2-90
+		-----------------------------------------------------------------
+	*/
+	bool read_drivers_from_file(	const std::wstring& path,
+									std::vector<EthDriver>& drivers_out,
+									std::wstring& error_message,
+									const ReadOptions& options)
+	{
+		drivers_out.clear();
+		error_message.clear();
+
+		Diagnostics::List diagnostics(1);
+		ScratchArena scratch(options.memory);
+		DriverBuilder builder(drivers_out, scratch.resource());
+		if (!scan_csv_file(path, &builder, diagnostics, options, NO_CHUNK_LIMIT, ScanMode::FirstError))
+		{
+			drivers_out.clear();
+			error_message = diagnostics.format(0);
+			return false;
+		}
+
+		return true;
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: read_drivers_from_file
+
+		Desc: Same as above, but keeps going past bad lines and records
+			  every problem in diagnostics (up to its limit) in a single
+			  pass. drivers_out is only filled if there were none.
+		-----------------------------------------------------------------
+	*/
+	bool read_drivers_from_file(	const std::wstring& path,
+									std::vector<EthDriver>& drivers_out,
+									Diagnostics::List& diagnostics,
+									const ReadOptions& options)
+	{
+		drivers_out.clear();
+
+		ScratchArena scratch(options.memory);
+		DriverBuilder builder(drivers_out, scratch.resource());
+		if (!scan_csv_file(path, &builder, diagnostics, options, NO_CHUNK_LIMIT, ScanMode::AllErrors))
+		{
+			drivers_out.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: read_drivers_from_files
+
+		Desc: Reads several CSV files at once, one thread per file, and
+			  combines them in the order given. Each file is read with
+			  the all-errors parser; its problems are copied into
+			  diagnostics, prefixed with the file's path. Drivers that
+			  appear in more than one file are resolved by policy.
+
+			  drivers_out is only filled if no problems were found.
+		-----------------------------------------------------------------
+	*/
+	bool read_drivers_from_files(	const std::vector<std::wstring>& paths,
+									std::vector<EthDriver>& drivers_out,
+									Diagnostics::List& diagnostics,
+									ConflictPolicy policy,
+									const ReadOptions& options)
+	{
+		drivers_out.clear();
+
+		const std::size_t first_diagnostic = diagnostics.size();
+		const std::vector<unsigned> threads = split_threads(paths, options.threads);
+
+		std::vector<std::vector<EthDriver>> results(paths.size());
+		// One spare slot per file, so copying a truncated list marks diagnostics truncated too
+		std::vector<Diagnostics::List> problems(paths.size(), Diagnostics::List(diagnostics.limit() + 1));
+
+		// ---- Parse every file on its own thread ----
+		{
+			std::vector<std::thread> workers;
+			workers.reserve(paths.size());
+			for (std::size_t i = 0; i < paths.size(); ++i)
+			{
+				workers.emplace_back([&, i] {
+					ReadOptions file_options = options;
+					file_options.threads = threads[i];
+					file_options.memory = nullptr;		// each file gets its own arena
+					read_drivers_from_file(paths[i], results[i], problems[i], file_options);
+				});
 			}
+
+			for (std::thread& worker : workers)
+				worker.join();
+		}
+
+		// ---- Combine in file order ----
+		for (std::size_t i = 0; i < paths.size(); ++i)
+		{
+			for (std::size_t e = 0; e < problems[i].size(); ++e)
+				diagnostics.add(problems[i], e, paths[i]);
+		}
+
+		if (diagnostics.size() != first_diagnostic)
+			return false;
+
+		ScratchArena scratch(options.memory);
+		std::pmr::vector<std::size_t> origin(scratch.resource());
+		std::pmr::unordered_map<DriverName, std::size_t> index(scratch.resource());
+		for (std::size_t i = 0; i < paths.size(); ++i)
+			combine_drivers(std::move(results[i]), i, paths, policy, drivers_out, origin, index, diagnostics);
+
+		if (diagnostics.size() != first_diagnostic)
+		{
+			drivers_out.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: read_patch_from_file
+
+		Desc: Reads a patch CSV of node-level changes, grouped by driver
+			  in order of first appearance. Each row is validated like a
+			  regular import row, plus a leading Op column.
+
+			  Patches are small, so this is a plain serial pass; every
+			  problem is recorded (up to the list's limit), and
+			  patches_out is only filled if there were none.
+
+		Format: Op,Type,Name,Range
+		Example: +,AB_ETH,FL-IRVING,192.168.2.10-12
+				 -,AB_ETH,FL-IRVING,192.168.2.40
+		-----------------------------------------------------------------
+	*/
+	bool read_patch_from_file(		const std::wstring& path,
+									std::vector<DriverPatch>& patches_out,
+									Diagnostics::List& diagnostics,
+									std::pmr::memory_resource* memory)
+	{
+		patches_out.clear();
+		const std::size_t first_diagnostic = diagnostics.size();
+
+		MappedFile file;
+		if (file.Open(path) != ERROR_SUCCESS)
+		{
+			diagnostics.add(Code::OpenFailed, 0, Diagnostics::COLUMN_NONE, {}, path);
+			return false;
+		}
+
+		std::string transcoded;
+		Kind kind = Kind::UTF8;
+		Tokenizer tokenizer(decode_text(file.View(), transcoded, kind));
+		std::string_view cols[4];
+
+		// ---- Check header ----
+		const std::size_t header_count = tokenizer.next_row(cols, 4);
+		if (header_count == 0)
+		{
+			diagnostics.add(Code::EmptyFile);
+			return false;
+		}
+
+		if (header_count < 4 ||
+			cols[0] != "Op" ||
+			cols[1] != "Type" ||
+			cols[2] != "Name" ||
+			cols[3] != "Range")
+		{
+			diagnostics.add(Code::PatchHeader, 1);
+			return false;
+		}
+
+		// ---- Rows ----
+		ScratchArena scratch(memory);
+		std::pmr::unordered_map<std::string_view, std::size_t> index(scratch.resource());		// name slice -> patch index
+
+		std::uint32_t line = 1;
+		for (std::size_t count; (count = tokenizer.next_row(cols, 4)) != 0 && !diagnostics.full(); )
+		{
+			++line;
+
+			// Allow completely blank lines
+			if (count == 1 && cols[0].empty())
+				continue;
+
+			if (count < 4)
+			{
+				diagnostics.add(Code::PatchColumnCount, line);
+				continue;
+			}
+
+			PatchOp op;
+			if (cols[0] == "+")
+				op = PatchOp::Add;
+			else if (cols[0] == "-")
+				op = PatchOp::Remove;
 			else
 			{
-				// Treat as a single IP
-				if (!is_valid_ipv4(range))
+				diagnostics.add(Code::UnsupportedOp, line, Diagnostics::COLUMN_NONE, {},
+					Encoding::to_wide(cols[0], kind));
+				continue;
+			}
+
+			// Type,Name,Range follow the import rules (columns shifted by one)
+			CsvRow row;
+			RowError error;
+			if (!check_row(cols + 1, 3, kind, row, error))
+			{
+				diagnostics.add(error.code, line, error.column, {}, Encoding::to_wide(error.text, kind));
+				continue;
+			}
+
+			if (diagnostics.size() != first_diagnostic)
+				continue;		// only validating from here on
+
+			auto found = index.find(row.name);
+			if (found == index.end())
+			{
+				found = index.emplace(row.name, patches_out.size()).first;
+				patches_out.push_back({ DriverName(Encoding::to_wide(row.name, kind)), {} });
+			}
+
+			std::vector<NodeChange>& changes = patches_out[found->second].changes;
+			for (std::uint32_t address = row.nodes.first; ; ++address)
+			{
+				changes.push_back({ op, address, line });
+				if (address == row.nodes.last)
+					break;
+			}
+		}
+
+		if (diagnostics.size() != first_diagnostic)
+		{
+			patches_out.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: stream_drivers_from_file
+
+		Desc: Bounded-memory import for files too large to hold as an
+			  EthDriver list.
+
+			  The file is validated in one pass while rows are sorted by
+			  driver name into temporary run files. A k-way merge then
+			  rebuilds one driver at a time and hands it to on_driver,
+			  so peak memory follows options.memory_budget rather than
+			  the file size.
+
+			  Drivers arrive in order of their name bytes, each with its
+			  nodes in file order. Format errors are reported before any
+			  driver is emitted; a duplicate node or 254-node error stops
+			  the stream at the driver that has it.
+
+			  Return false from on_driver to stop early.
+		-----------------------------------------------------------------
+	*/
+	bool stream_drivers_from_file(	const std::wstring& path,
+									const std::function<bool(EthDriver&&)>& on_driver,
+									std::wstring& error_message,
+									const StreamOptions& options)
+	{
+		error_message.clear();
+
+		const std::size_t budget = std::max(options.memory_budget, MIN_STREAM_BUDGET);
+		Diagnostics::List diagnostics(1);
+
+		RunStore store(options.temp_dir, sizeof(RunRecord));
+		if (!store.is_open())
+		{
+			diagnostics.add(Code::TempDirectoryFailed);
+			error_message = diagnostics.format(0);
+			return false;
+		}
+
+		// Half the budget sorts rows into runs; the parser's chunk window
+		// (two chunks per thread) is sized to stay within a quarter.
+		ReadOptions read = options;
+		const unsigned max_threads = static_cast<unsigned>(std::max<std::size_t>(1, budget / (MIN_CHUNK_BYTES * 16)));
+		read.threads = (read.threads == 0) ? std::thread::hardware_concurrency() : read.threads;
+		read.threads = std::max(1u, std::min(read.threads, max_threads));
+
+		RunSink sink(store, budget / 2 / sizeof(RunRecord));
+		if (!scan_csv_file(path, &sink, diagnostics, read, MIN_CHUNK_BYTES, ScanMode::FirstError))
+		{
+			error_message = diagnostics.format(0);
+			return false;
+		}
+
+		// ---- Merge runs, one driver at a time ----
+		// The builder is reset per driver, so its state comes from a pool
+		// that reuses the blocks rather than an arena that would keep growing
+		std::pmr::unsynchronized_pool_resource pool(options.memory != nullptr ? options.memory : std::pmr::get_default_resource());
+		std::vector<EthDriver> current;
+		DriverBuilder builder(current, &pool);
+		builder.set_kind(sink.kind());
+
+		std::string name;				// the current driver's name bytes; builder keys point here
+		bool stopped = false;
+
+		auto emit = [&]() {
+			if (current.empty())
+				return true;
+
+			builder.finish(diagnostics);
+			EthDriver driver = std::move(current.front());
+			builder.reset();
+
+			if (!on_driver(std::move(driver)))
+				stopped = true;
+			return !stopped;
+			};
+
+		const bool merged = store.merge(budget / 2, run_record_less,
+			[&](const char* bytes) {
+				RunRecord record;
+				std::memcpy(&record, bytes, sizeof(record));
+
+				const std::string_view record_name(record.name, record.name_length);
+				if (record_name != name)
 				{
-					error_message = L"Line " + std::to_wstring(line_num) +
-									L": Range \"" + range +
-									L"\" is neither a valid IPv4 address "
-									L"nor a valid range.";
-					return false;
+					if (!emit())
+						return false;
+					name.assign(record_name);
 				}
-			}
 
-			++line_num;
+				CsvRow row;
+				row.name = name;
+				row.nodes.first = record.first;
+				row.nodes.last = record.last;
+				return builder.apply(row, static_cast<std::size_t>(record.line), diagnostics);
+			});
+
+		if (!merged)
+			diagnostics.add(Code::TempReadFailed);
+
+		if (!diagnostics.empty())
+		{
+			error_message = diagnostics.format(0);
+			return false;
+		}
+
+		if (!stopped)
+			emit();
+
+		return true;
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: write_drivers_to_file
+
+		Desc: Writes existing ETH drivers to a CSV file
+		-----------------------------------------------------------------
+	*/
+	bool write_drivers_to_file(		const std::wstring& path,
+									const std::vector<EthDriver>& drivers_in,
+									std::wstring& error_message,
+									const WriteOptions& options)
+	{
+		DriverWriter file;
+		if (!file.open(path, error_message))
+			return false;
+
+		file.write(drivers_in, options);
+		return file.close(error_message);
+	}
+
+	/*	-----------------------------------------------------------------
+		Class: DriverWriter
+
+		Desc: Incremental form of write_drivers_to_file. Each driver's
+			  rows go into the writer's buffer as soon as write() is
+			  called and reach the file in 1 MB blocks, so memory stays
+			  constant however many drivers are exported.
+		-----------------------------------------------------------------
+	*/
+	bool DriverWriter::open(const std::wstring& path, std::wstring& error_message)
+	{
+		error_message.clear();
+		m_path = path;
+		m_count = 0;
+
+		if (!m_file.open(path))
+		{
+			error_message = L"Failed to open file for writing: " + path;
+			return false;
+		}
+
+		//CSV Header
+		m_file.text(std::string_view("Type,Name,Range"));
+		m_file.end_row();
+		return true;
+	}
+
+	void DriverWriter::write(const EthDriver& driver)
+	{
+		DriverRanges ranges;
+		write_driver_rows(m_file, driver, ranges);
+		++m_count;
+	}
+
+	void DriverWriter::write(const std::vector<EthDriver>& drivers, const WriteOptions& options)
+	{
+		format_drivers(drivers, options.threads, [this](std::string_view rows) { m_file.text(rows); });
+		m_count += drivers.size();
+	}
+
+	void DriverWriter::write_rows(std::string_view rows)
+	{
+		m_file.text(rows);
+		++m_count;
+	}
+
+	bool DriverWriter::close(std::wstring& error_message)
+	{
+		error_message.clear();
+		if (!m_file.close())
+		{
+			error_message = L"Error occurred while writing to file: " + m_path;
+			return false;
+		}
+
+		return true;
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: validate_csv_format
+
+		Desc: Validation to check the CSV file format is correct.
+			  Runs the import engine in validate-only mode.
+		-----------------------------------------------------------------
+	*/
+	bool validate_csv_format(		const std::wstring& path,
+									std::wstring& error_message,
+									const ReadOptions& options)
+	{
+		error_message.clear();
+
+		Diagnostics::List diagnostics(1);
+		if (!scan_csv_file<DriverBuilder>(path, nullptr, diagnostics, options, NO_CHUNK_LIMIT, ScanMode::FirstError))
+		{
+			error_message = diagnostics.format(0);
+			return false;
 		}
 
 		return true;
 	}
+
+	bool validate_csv_format(		const std::wstring& path,
+									Diagnostics::List& diagnostics,
+									const ReadOptions& options)
+	{
+		return scan_csv_file<DriverBuilder>(path, nullptr, diagnostics, options, NO_CHUNK_LIMIT, ScanMode::AllErrors);
+	}
 }	// namespace CSV
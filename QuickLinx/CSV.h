@@ -1,8 +1,14 @@
 #pragma once
 #include "EthDriver.h"
+#include "Diagnostics.h"
+#include "DriverPatch.h"
+#include "CSVWriter.h"
 
 #include <string>
 #include <vector>
+#include <functional>
+#include <cstddef>
+#include <memory_resource>
 
 /*
 	File: CSV.h
@@ -16,17 +22,115 @@
 
 namespace CSV
 {
+	// Tuning knobs for reading large CSV files
+	struct ReadOptions
+	{
+		unsigned		threads = 0;		// Worker threads for chunked parsing (0 = one per hardware thread)
+		std::wstring	cache_dir;			// Directory for cached chunk results (empty = no cache)
+
+		// Scratch memory for the parse (see ScratchArena.h). nullptr = an arena per
+		// read, released when it returns. Only used from the calling thread.
+		std::pmr::memory_resource*	memory = nullptr;
+	};
+
+	// Tuning knobs for writing large CSV files
+	struct WriteOptions
+	{
+		unsigned		threads = 0;		// Worker threads formatting driver rows (0 = one per hardware thread)
+	};
+
+	// Options for stream_drivers_from_file
+	struct StreamOptions : ReadOptions
+	{
+		std::size_t		memory_budget = std::size_t(64) << 20;	// Bytes for sort buffers and merge (64 MB)
+		std::wstring	temp_dir;			// Directory for temporary run files (empty = system temp)
+	};
+
 	//Parse CSV file into EthDriver Struct
 	bool read_drivers_from_file(	const std::wstring& path, 
 									std::vector<EthDriver>& drivers_out, 
-									std::wstring& error_message);
+									std::wstring& error_message,
+									const ReadOptions& options = ReadOptions());
+
+	//Parse CSV file, recording every problem (up to the list's limit) in one pass
+	bool read_drivers_from_file(	const std::wstring& path,
+									std::vector<EthDriver>& drivers_out,
+									Diagnostics::List& diagnostics,
+									const ReadOptions& options = ReadOptions());
+
+	// What read_drivers_from_files does with a driver name found in more than one file
+	enum class ConflictPolicy
+	{
+		FirstWins,		// keep the driver from the earliest file in the list
+		UnionNodes,		// keep the earliest driver and append nodes it lacks from later files
+		Error			// report each repeated driver as a problem
+	};
+
+	//Parse several CSV files concurrently (one thread per file) into one driver list.
+	//Drivers are ordered by file, then by first appearance in the file, and
+	//conflicts are resolved in file order, so the result does not depend on timing.
+	//Problems are prefixed with the file they came from.
+	bool read_drivers_from_files(	const std::vector<std::wstring>& paths,
+									std::vector<EthDriver>& drivers_out,
+									Diagnostics::List& diagnostics,
+									ConflictPolicy policy,
+									const ReadOptions& options = ReadOptions());
+
+	//Parse a patch CSV (Op,Type,Name,Range; Op is "+" or "-") into node-level
+	//changes per driver, recording every problem (up to the list's limit)
+	bool read_patch_from_file(		const std::wstring& path,
+									std::vector<DriverPatch>& patches_out,
+									Diagnostics::List& diagnostics,
+									std::pmr::memory_resource* memory = nullptr);
+
+	//Import a CSV file too large for memory: drivers are handed to on_driver one at a
+	//time, in name order. Return false from on_driver to stop early. UTF-16 input
+	//is transcoded a chunk at a time, so it stays within memory_budget too.
+	bool stream_drivers_from_file(	const std::wstring& path,
+									const std::function<bool(EthDriver&&)>& on_driver,
+									std::wstring& error_message,
+									const StreamOptions& options = StreamOptions());
 
 	//Write drivers back to CSV file
 	bool write_drivers_to_file(		const std::wstring& path,
 									const std::vector<EthDriver>& drivers_in,
-									std::wstring& error_message);
+									std::wstring& error_message,
+									const WriteOptions& options = WriteOptions());
+
+	//Write drivers to a CSV file one at a time, as they are produced, so the
+	//full list never has to be in memory: open(), write() each driver, close()
+	class DriverWriter
+	{
+	public:
+		bool open(const std::wstring& path, std::wstring& error_message);
+		void write(const EthDriver& driver);
+
+		// Write a whole list; large lists are formatted on worker threads
+		// with output identical to writing them one at a time
+		void write(const std::vector<EthDriver>& drivers, const WriteOptions& options = WriteOptions());
+
+		// Rows of one driver that are already formatted, e.g. copied from a previous export
+		void write_rows(std::string_view rows);
+
+		// File offset of the next driver's rows
+		std::uint64_t position() const noexcept { return m_file.position(); }
+		bool close(std::wstring& error_message);
+
+		std::size_t count() const noexcept { return m_count; }
+
+	private:
+		Writer			m_file;
+		std::wstring	m_path;
+		std::size_t		m_count = 0;
+	};
 
 	//Validate CSV file format
 	bool validate_csv_format(		const std::wstring& path,
-									std::wstring& error_message);
+									std::wstring& error_message,
+									const ReadOptions& options = ReadOptions());
+
+	//Validate CSV file format, recording every problem (up to the list's limit)
+	bool validate_csv_format(		const std::wstring& path,
+									Diagnostics::List& diagnostics,
+									const ReadOptions& options = ReadOptions());
 }
\ No newline at end of file
@@ -0,0 +1,344 @@
+#include "CSVCache.h"
+#include "CSVScan.h"
+
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	constexpr std::size_t MIN_CHUNK = std::size_t(64) << 10;		// 64 KB
+	constexpr std::size_t MAX_CHUNK = std::size_t(1) << 20;			// 1 MB
+	constexpr std::uint64_t BOUNDARY_MASK = (std::uint64_t(1) << 18) - 1;	// ~256 KB average
+
+	constexpr std::uint32_t ENTRY_MAGIC = 0x43584C51;	// "QLXC"
+	constexpr std::uint32_t ENTRY_VERSION = 2;
+
+	struct EntryHeader
+	{
+		std::uint32_t	magic;
+		std::uint32_t	version;
+		std::uint64_t	key;
+		std::uint64_t	chunk_size;
+		std::uint64_t	check;				// check_bytes of the chunk
+		std::uint64_t	blob_size;
+	};
+
+	constexpr std::uint64_t splitmix64(std::uint64_t x) noexcept
+	{
+		x += 0x9E3779B97F4A7C15ull;
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+		return x ^ (x >> 31);
+	}
+
+	// Random value per byte for the rolling "gear" hash
+	constexpr std::array<std::uint64_t, 256> make_gear_table() noexcept
+	{
+		std::array<std::uint64_t, 256> table = {};
+		for (std::size_t i = 0; i < table.size(); ++i)
+			table[i] = splitmix64(i);
+		return table;
+	}
+
+	constexpr std::array<std::uint64_t, 256> GEAR = make_gear_table();
+
+	inline std::uint64_t mix(std::uint64_t h, std::uint64_t word) noexcept
+	{
+		h ^= word * 0x9E3779B97F4A7C15ull;
+		h = (h << 31) | (h >> 33);
+		return h * 0xC2B2AE3D27D4EB4Full;
+	}
+
+	// XXH64 primes and steps, for check_bytes
+	constexpr std::uint64_t XXH_PRIME1 = 0x9E3779B185EBCA87ull;
+	constexpr std::uint64_t XXH_PRIME2 = 0xC2B2AE3D27D4EB4Full;
+	constexpr std::uint64_t XXH_PRIME3 = 0x165667B19E3779F9ull;
+	constexpr std::uint64_t XXH_PRIME4 = 0x85EBCA77C2B2AE63ull;
+	constexpr std::uint64_t XXH_PRIME5 = 0x27D4EB2F165667C5ull;
+
+	constexpr std::uint64_t rotl(std::uint64_t x, int r) noexcept
+	{
+		return (x << r) | (x >> (64 - r));
+	}
+
+	constexpr std::uint64_t xxh_round(std::uint64_t acc, std::uint64_t word) noexcept
+	{
+		return rotl(acc + word * XXH_PRIME2, 31) * XXH_PRIME1;
+	}
+
+	constexpr std::uint64_t xxh_merge(std::uint64_t h, std::uint64_t acc) noexcept
+	{
+		return (h ^ xxh_round(0, acc)) * XXH_PRIME1 + XXH_PRIME4;
+	}
+
+	inline std::uint64_t load64(const unsigned char* p) noexcept
+	{
+		std::uint64_t word;
+		std::memcpy(&word, p, sizeof(word));
+		return word;
+	}
+
+	inline std::uint32_t load32(const unsigned char* p) noexcept
+	{
+		std::uint32_t word;
+		std::memcpy(&word, p, sizeof(word));
+		return word;
+	}
+
+	// End of the chunk starting at pos: the first '\n' past MIN_CHUNK where
+	// the rolling hash hits the boundary pattern, or the first '\n' past MAX_CHUNK.
+	std::size_t find_boundary(std::string_view data, std::size_t pos) noexcept
+	{
+		const std::size_t remaining = data.size() - pos;
+		if (remaining <= MIN_CHUNK)
+			return data.size();
+
+		const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+		const std::size_t limit = pos + std::min(remaining, MAX_CHUNK);
+
+		// The gear hash only remembers the last 64 bytes, so warm it up just
+		// before the first candidate position
+		std::uint64_t h = 0;
+		for (std::size_t i = pos + MIN_CHUNK - 64; i < pos + MIN_CHUNK; ++i)
+			h = (h << 1) + GEAR[bytes[i]];
+
+		for (std::size_t i = pos + MIN_CHUNK; i < limit; ++i)
+		{
+			h = (h << 1) + GEAR[bytes[i]];
+			if (bytes[i] == '\n' && (h & BOUNDARY_MASK) == 0)
+				return i + 1;
+		}
+
+		if (limit == data.size())
+			return data.size();
+
+		const char* last = data.data() + data.size();
+		const char* newline = CSV::Scan::find_newline(data.data() + limit, last);
+		return (newline == last) ? data.size() : static_cast<std::size_t>(newline - data.data()) + 1;
+	}
+}	// namespace
+
+namespace CSV
+{
+	std::uint64_t hash_bytes(std::string_view data, std::uint64_t seed) noexcept
+	{
+		std::uint64_t h = splitmix64(seed ^ data.size());
+		const char* p = data.data();
+		std::size_t n = data.size();
+
+		for (; n >= 8; p += 8, n -= 8)
+		{
+			std::uint64_t word = 0;
+			std::memcpy(&word, p, 8);
+			h = mix(h, word);
+		}
+
+		std::uint64_t tail = 0;
+		std::memcpy(&tail, p, n);
+		return splitmix64(mix(h, tail));
+	}
+
+	std::uint64_t check_bytes(std::string_view data) noexcept
+	{
+		const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+		const unsigned char* const end = p + data.size();
+		std::uint64_t h;
+
+		if (data.size() >= 32)
+		{
+			std::uint64_t v1 = XXH_PRIME1 + XXH_PRIME2;
+			std::uint64_t v2 = XXH_PRIME2;
+			std::uint64_t v3 = 0;
+			std::uint64_t v4 = 0 - XXH_PRIME1;
+
+			for (; end - p >= 32; p += 32)
+			{
+				v1 = xxh_round(v1, load64(p));
+				v2 = xxh_round(v2, load64(p + 8));
+				v3 = xxh_round(v3, load64(p + 16));
+				v4 = xxh_round(v4, load64(p + 24));
+			}
+
+			h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+			h = xxh_merge(h, v1);
+			h = xxh_merge(h, v2);
+			h = xxh_merge(h, v3);
+			h = xxh_merge(h, v4);
+		}
+		else
+		{
+			h = XXH_PRIME5;
+		}
+
+		h += static_cast<std::uint64_t>(data.size());
+
+		for (; end - p >= 8; p += 8)
+			h = rotl(h ^ xxh_round(0, load64(p)), 27) * XXH_PRIME1 + XXH_PRIME4;
+
+		if (end - p >= 4)
+		{
+			h = rotl(h ^ (std::uint64_t(load32(p)) * XXH_PRIME1), 23) * XXH_PRIME2 + XXH_PRIME3;
+			p += 4;
+		}
+
+		for (; p < end; ++p)
+			h = rotl(h ^ (*p * XXH_PRIME5), 11) * XXH_PRIME1;
+
+		h ^= h >> 33;
+		h *= XXH_PRIME2;
+		h ^= h >> 29;
+		h *= XXH_PRIME3;
+		return h ^ (h >> 32);
+	}
+
+	std::vector<std::string_view> split_content_defined(std::string_view data)
+	{
+		std::vector<std::string_view> chunks;
+		std::size_t pos = 0;
+
+		while (pos < data.size())
+		{
+			const std::size_t end = find_boundary(data, pos);
+			chunks.push_back(data.substr(pos, end - pos));
+			pos = end;
+		}
+
+		return chunks;
+	}
+
+	ChunkCache::ChunkCache(const std::wstring& directory)
+		: m_directory(directory)
+	{
+		if (m_directory.empty())
+			return;
+
+		std::error_code ec;
+		fs::create_directories(fs::path(m_directory), ec);
+		if (!fs::is_directory(fs::path(m_directory), ec))
+			m_directory.clear();
+	}
+
+	std::wstring ChunkCache::entry_path(std::uint64_t key) const
+	{
+		static const wchar_t HEX[] = L"0123456789abcdef";
+
+		std::wstring name(16, L'0');
+		for (int i = 15; i >= 0; --i, key >>= 4)
+			name[i] = HEX[key & 0xF];
+
+		return (fs::path(m_directory) / (name + L".qlc")).wstring();
+	}
+
+	bool ChunkCache::load(		std::uint64_t key,
+								std::string_view chunk,
+								std::string& blob_out) const
+	{
+		if (!is_enabled())
+			return false;
+
+		const fs::path path(entry_path(key));
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+			return false;
+
+		EntryHeader header = {};
+		if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+			header.magic != ENTRY_MAGIC ||
+			header.version != ENTRY_VERSION ||
+			header.key != key ||
+			header.chunk_size != chunk.size() ||
+			header.blob_size > chunk.size() * 16 + 64 ||
+			header.check != check_bytes(chunk))
+		{
+			return false;
+		}
+
+		blob_out.resize(static_cast<std::size_t>(header.blob_size));
+		if (!file.read(&blob_out[0], static_cast<std::streamsize>(blob_out.size())))
+			return false;
+
+		file.close();
+
+		// Mark as recently used for trim()
+		std::error_code ec;
+		fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+		return true;
+	}
+
+	void ChunkCache::store(		std::uint64_t key,
+								std::string_view chunk,
+								const std::string& blob) const
+	{
+		if (!is_enabled())
+			return;
+
+		// Write under a per-thread name and rename, so readers never see a partial entry
+		const fs::path path(entry_path(key));
+		fs::path temp = path;
+		temp += L"." + std::to_wstring(std::hash<std::thread::id>()(std::this_thread::get_id())) + L".tmp";
+
+		{
+			std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+			if (!file.is_open())
+				return;
+
+			const EntryHeader header = { ENTRY_MAGIC, ENTRY_VERSION, key, chunk.size(), check_bytes(chunk), blob.size() };
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+			if (!file)
+			{
+				file.close();
+				std::error_code ec;
+				fs::remove(temp, ec);
+				return;
+			}
+		}
+
+		std::error_code ec;
+		fs::rename(temp, path, ec);
+		if (ec)
+			fs::remove(temp, ec);
+	}
+
+	void ChunkCache::trim(std::size_t max_entries) const
+	{
+		if (!is_enabled())
+			return;
+
+		struct Entry
+		{
+			fs::path			path;
+			fs::file_time_type	time;
+		};
+
+		std::vector<Entry> entries;
+		std::error_code ec;
+		for (fs::directory_iterator it(fs::path(m_directory), ec), end; !ec && it != end; it.increment(ec))
+		{
+			if (it->path().extension() != L".qlc")
+				continue;
+
+			std::error_code time_ec;
+			const fs::file_time_type time = it->last_write_time(time_ec);
+			if (!time_ec)
+				entries.push_back({ it->path(), time });
+		}
+
+		if (entries.size() <= max_entries)
+			return;
+
+		// Oldest first
+		std::sort(entries.begin(), entries.end(),
+			[](const Entry& a, const Entry& b) { return a.time < b.time; });
+
+		for (std::size_t i = 0; i < entries.size() - max_entries; ++i)
+			fs::remove(entries[i].path, ec);
+	}
+}	// namespace CSV
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/*
+	File: CSVCache.h
+
+	Desc: On-disk cache of parsed CSV chunks, keyed by chunk content.
+
+		  split_content_defined cuts the data lines at boundaries chosen
+		  by a rolling hash of the bytes themselves, so editing a few rows
+		  only changes the chunks that contain them; every other chunk
+		  keeps the same bytes, and therefore the same key, as the
+		  previous import.
+
+		  The cache only stores opaque blobs. CSV.cpp decides what goes
+		  in them. Failures to read or write the cache are never errors:
+		  a missing or unreadable entry is simply re-parsed.
+*/
+
+
+namespace CSV
+{
+	// 64-bit content hash of a chunk
+	std::uint64_t hash_bytes(std::string_view data, std::uint64_t seed) noexcept;
+
+	// A second 64-bit content hash, computed differently from hash_bytes
+	// (XXH64), that cache entries are verified against
+	std::uint64_t check_bytes(std::string_view data) noexcept;
+
+	// Cut data into content-defined slices (64 KB - 1 MB), each ending just after a '\n'
+	std::vector<std::string_view> split_content_defined(std::string_view data);
+
+	class ChunkCache
+	{
+	public:
+		// An empty directory disables the cache
+		explicit ChunkCache(const std::wstring& directory);
+
+		bool is_enabled() const noexcept { return !m_directory.empty(); }
+
+		// Fetch the blob stored for key. An entry is only used if its chunk
+		// also had the same length and the same second, independent hash
+		// (check_bytes), so a collision on the 64-bit key is never a hit.
+		bool load(			std::uint64_t key,
+							std::string_view chunk,
+							std::string& blob_out) const;
+
+		void store(			std::uint64_t key,
+							std::string_view chunk,
+							const std::string& blob) const;
+
+		// Drop the least recently used entries beyond max_entries
+		void trim(std::size_t max_entries) const;
+
+	private:
+		std::wstring entry_path(std::uint64_t key) const;
+
+		std::wstring	m_directory;
+	};
+}
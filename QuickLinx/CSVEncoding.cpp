@@ -0,0 +1,319 @@
+#include "CSVEncoding.h"
+
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define QLX_ENCODING_SSE2 1
+	#include <emmintrin.h>
+#endif
+
+namespace
+{
+	using CSV::Encoding::Kind;
+
+	constexpr std::uint32_t REPLACEMENT = 0xFFFD;
+
+	/*	-----------------------------------------------------------------
+		Function: decode_utf8_char
+
+		Desc: Decodes one UTF-8 sequence starting at p. Returns its
+			  length in bytes, or 0 if the sequence is malformed
+			  (bad lead byte, truncated, overlong, or a surrogate).
+		-----------------------------------------------------------------
+	*/
+	std::size_t decode_utf8_char(	const unsigned char* p,
+									const unsigned char* end,
+									std::uint32_t& cp) noexcept
+	{
+		const unsigned char lead = p[0];
+		if (lead < 0x80)
+		{
+			cp = lead;
+			return 1;
+		}
+
+		std::size_t length = 0;
+		std::uint32_t min = 0;
+		if (lead >= 0xC2 && lead <= 0xDF)		{ length = 2; min = 0x80;		cp = lead & 0x1F; }
+		else if (lead >= 0xE0 && lead <= 0xEF)	{ length = 3; min = 0x800;		cp = lead & 0x0F; }
+		else if (lead >= 0xF0 && lead <= 0xF4)	{ length = 4; min = 0x10000;	cp = lead & 0x07; }
+		else
+			return 0;
+
+		if (static_cast<std::size_t>(end - p) < length)
+			return 0;
+
+		for (std::size_t i = 1; i < length; ++i)
+		{
+			if ((p[i] & 0xC0) != 0x80)
+				return 0;
+			cp = (cp << 6) | (p[i] & 0x3F);
+		}
+
+		if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+			return 0;
+
+		return length;
+	}
+
+	// Length of the run of ASCII bytes at the start of [p, end)
+	std::size_t ascii_prefix(const unsigned char* p, const unsigned char* end) noexcept
+	{
+		const unsigned char* start = p;
+	#if defined(QLX_ENCODING_SSE2)
+		for (; end - p >= 16; p += 16)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			if (_mm_movemask_epi8(v) != 0)
+				break;
+		}
+	#endif
+		while (p < end && *p < 0x80)
+			++p;
+		return static_cast<std::size_t>(p - start);
+	}
+
+	// Copy n ASCII bytes into wide characters
+	void widen_ascii(const unsigned char* p, std::size_t n, wchar_t* out) noexcept
+	{
+		std::size_t i = 0;
+	#if defined(QLX_ENCODING_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		for (; i + 16 <= n; i += 16)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			const __m128i lo = _mm_unpacklo_epi8(v, zero);
+			const __m128i hi = _mm_unpackhi_epi8(v, zero);
+
+			if constexpr (sizeof(wchar_t) == 2)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), lo);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), hi);
+			}
+			else
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(lo, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(lo, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpacklo_epi16(hi, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 12), _mm_unpackhi_epi16(hi, zero));
+			}
+		}
+	#endif
+		for (; i < n; ++i)
+			out[i] = static_cast<wchar_t>(p[i]);
+	}
+
+	// Store a code point as one or two wchar_t (UTF-16 where wchar_t is 16-bit)
+	wchar_t* put_wide(std::uint32_t cp, wchar_t* out) noexcept
+	{
+		if constexpr (sizeof(wchar_t) == 2)
+		{
+			if (cp >= 0x10000)
+			{
+				cp -= 0x10000;
+				*out++ = static_cast<wchar_t>(0xD800 + (cp >> 10));
+				*out++ = static_cast<wchar_t>(0xDC00 + (cp & 0x3FF));
+				return out;
+			}
+		}
+		*out++ = static_cast<wchar_t>(cp);
+		return out;
+	}
+
+	void put_utf8(std::uint32_t cp, std::string& out)
+	{
+		if (cp < 0x80)
+		{
+			out += static_cast<char>(cp);
+		}
+		else if (cp < 0x800)
+		{
+			out += static_cast<char>(0xC0 | (cp >> 6));
+			out += static_cast<char>(0x80 | (cp & 0x3F));
+		}
+		else if (cp < 0x10000)
+		{
+			out += static_cast<char>(0xE0 | (cp >> 12));
+			out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (cp & 0x3F));
+		}
+		else
+		{
+			out += static_cast<char>(0xF0 | (cp >> 18));
+			out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+			out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (cp & 0x3F));
+		}
+	}
+
+	inline std::uint32_t load_unit(const unsigned char* p, bool big_endian) noexcept
+	{
+		return big_endian ? (std::uint32_t(p[0]) << 8) | p[1]
+						  : (std::uint32_t(p[1]) << 8) | p[0];
+	}
+}	// namespace
+
+namespace CSV
+{
+	namespace Encoding
+	{
+		Detected detect(std::string_view bytes) noexcept
+		{
+			const auto* p = reinterpret_cast<const unsigned char*>(bytes.data());
+			const std::size_t size = bytes.size();
+
+			if (size >= 3 && p[0] == 0xEF && p[1] == 0xBB && p[2] == 0xBF)
+				return { Kind::UTF8, 3 };
+			if (size >= 2 && p[0] == 0xFF && p[1] == 0xFE)
+				return { Kind::UTF16LE, 2 };
+			if (size >= 2 && p[0] == 0xFE && p[1] == 0xFF)
+				return { Kind::UTF16BE, 2 };
+
+			if (size >= 2 && p[0] != 0 && p[1] == 0)
+				return { Kind::UTF16LE, 0 };
+			if (size >= 2 && p[0] == 0 && p[1] != 0)
+				return { Kind::UTF16BE, 0 };
+
+			return { is_valid_utf8(bytes) ? Kind::UTF8 : Kind::Latin1, 0 };
+		}
+
+		bool is_valid_utf8(std::string_view bytes) noexcept
+		{
+			const auto* p = reinterpret_cast<const unsigned char*>(bytes.data());
+			const auto* end = p + bytes.size();
+
+			while (p < end)
+			{
+				p += ascii_prefix(p, end);
+				if (p == end)
+					break;
+
+				std::uint32_t cp = 0;
+				const std::size_t length = decode_utf8_char(p, end, cp);
+				if (length == 0)
+					return false;
+				p += length;
+			}
+			return true;
+		}
+
+		void utf16_to_utf8(	std::string_view bytes,
+							bool big_endian,
+							std::string& out)
+		{
+			const auto* p = reinterpret_cast<const unsigned char*>(bytes.data());
+			const auto* end = p + (bytes.size() & ~std::size_t(1));
+
+			out.clear();
+			out.reserve(bytes.size() / 2 + bytes.size() / 8);
+
+			while (p < end)
+			{
+			#if defined(QLX_ENCODING_SSE2)
+				// 8 code units at a time while they are all ASCII
+				char block[8];
+				while (end - p >= 16)
+				{
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+					if (big_endian)
+						v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+
+					const __m128i high = _mm_and_si128(v, _mm_set1_epi16(static_cast<short>(0xFF80)));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xFFFF)
+						break;
+
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(block), _mm_packus_epi16(v, v));
+					out.append(block, 8);
+					p += 16;
+				}
+				if (p == end)
+					break;
+			#endif
+
+				std::uint32_t cp = load_unit(p, big_endian);
+				p += 2;
+
+				if (cp >= 0xD800 && cp <= 0xDBFF)
+				{
+					const std::uint32_t low = (p < end) ? load_unit(p, big_endian) : 0;
+					if (low >= 0xDC00 && low <= 0xDFFF)
+					{
+						cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+						p += 2;
+					}
+					else
+					{
+						cp = REPLACEMENT;
+					}
+				}
+				else if (cp >= 0xDC00 && cp <= 0xDFFF)
+				{
+					cp = REPLACEMENT;
+				}
+
+				put_utf8(cp, out);
+			}
+
+			if (bytes.size() & 1)
+				put_utf8(REPLACEMENT, out);
+		}
+
+		std::wstring to_wide(std::string_view text, Kind kind)
+		{
+			const auto* p = reinterpret_cast<const unsigned char*>(text.data());
+			const auto* end = p + text.size();
+
+			// UTF-8 never needs more wchar_t than bytes
+			std::wstring wide(text.size(), L'\0');
+			wchar_t* out = &wide[0];
+
+			if (kind == Kind::Latin1)
+			{
+				widen_ascii(p, text.size(), out);
+				return wide;
+			}
+
+			while (p < end)
+			{
+				const std::size_t ascii = ascii_prefix(p, end);
+				widen_ascii(p, ascii, out);
+				p += ascii;
+				out += ascii;
+				if (p == end)
+					break;
+
+				std::uint32_t cp = 0;
+				std::size_t length = decode_utf8_char(p, end, cp);
+				if (length == 0)
+				{
+					cp = REPLACEMENT;
+					length = 1;
+				}
+				p += length;
+				out = put_wide(cp, out);
+			}
+
+			wide.resize(static_cast<std::size_t>(out - wide.data()));
+			return wide;
+		}
+
+		std::size_t wide_length(std::string_view text, Kind kind) noexcept
+		{
+			if (kind == Kind::Latin1)
+				return text.size();
+
+			// Every byte except continuation bytes starts a unit; 4-byte
+			// sequences need a surrogate pair
+			std::size_t length = 0;
+			for (const char ch : text)
+			{
+				const unsigned char byte = static_cast<unsigned char>(ch);
+				if ((byte & 0xC0) != 0x80)
+					++length;
+				if (byte >= 0xF0)
+					++length;
+			}
+			return length;
+		}
+	}
+}	// namespace CSV
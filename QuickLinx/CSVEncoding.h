@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+/*
+	File: CSVEncoding.h
+
+	Desc: Encoding detection and transcoding for CSV input.
+
+		  The tokenizer works on 8-bit text where ',', '\n' and whitespace
+		  are plain ASCII bytes, which holds for UTF-8 and single-byte
+		  code pages. UTF-16 files are transcoded to UTF-8, up front or
+		  a chunk at a time when streaming; everything else is tokenized
+		  in place and only the slices that end up in an EthDriver or a
+		  message are widened.
+
+		  Pure-ASCII blocks take a 16-byte SSE2 fast path in every
+		  conversion.
+*/
+
+
+namespace CSV
+{
+	namespace Encoding
+	{
+		enum class Kind
+		{
+			UTF8,
+			UTF16LE,
+			UTF16BE,
+			Latin1			// no BOM and not valid UTF-8: one byte per character
+		};
+
+		struct Detected
+		{
+			Kind			kind = Kind::UTF8;
+			std::size_t		bom_size = 0;		// bytes to skip before the text
+		};
+
+		// Look for a UTF-8 / UTF-16LE / UTF-16BE byte order mark. Without one,
+		// a zero byte in the first code unit means BOM-less UTF-16 (the
+		// header is ASCII); otherwise the text is UTF-8 if it validates,
+		// else Latin1.
+		Detected detect(std::string_view bytes) noexcept;
+
+		// True if bytes is well-formed UTF-8 (no overlongs or surrogates)
+		bool is_valid_utf8(std::string_view bytes) noexcept;
+
+		// Convert UTF-16 code units (BOM already removed) to UTF-8.
+		// Unpaired surrogates and a trailing odd byte become U+FFFD.
+		void utf16_to_utf8(	std::string_view bytes,
+							bool big_endian,
+							std::string& out);
+
+		// Widen UTF-8 or Latin1 text. Invalid UTF-8 becomes U+FFFD.
+		std::wstring to_wide(std::string_view text, Kind kind);
+
+		// Length of text in UTF-16 code units, i.e. as the registry stores it
+		std::size_t wide_length(std::string_view text, Kind kind) noexcept;
+	}
+}
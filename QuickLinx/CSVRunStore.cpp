@@ -0,0 +1,215 @@
+#include "CSVRunStore.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <queue>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	constexpr std::size_t MIN_RUN_BUFFER = std::size_t(64) << 10;		// 64 KB per open run
+
+	// Buffered sequential reader over one run file
+	class RunReader
+	{
+	public:
+		RunReader(const std::wstring& path, std::size_t record_size, std::size_t buffer_bytes)
+			: m_file(fs::path(path), std::ios::binary)
+			, m_record_size(record_size)
+			, m_buffer(std::max(record_size, buffer_bytes - buffer_bytes % record_size))
+		{}
+
+		bool good() const { return m_file.is_open() && !m_failed; }
+
+		// Current record, or nullptr at the end of the run (or on a read error)
+		const char* current()
+		{
+			if (m_pos == m_end && !refill())
+				return nullptr;
+			return m_buffer.data() + m_pos;
+		}
+
+		void advance() { m_pos += m_record_size; }
+
+	private:
+		bool refill()
+		{
+			m_file.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+			const std::size_t got = static_cast<std::size_t>(m_file.gcount());
+			if (got % m_record_size != 0)
+				m_failed = true;
+
+			m_pos = 0;
+			m_end = got - got % m_record_size;
+			return m_end != 0;
+		}
+
+		std::ifstream		m_file;
+		std::size_t			m_record_size;
+		std::vector<char>	m_buffer;
+		std::size_t			m_pos = 0;
+		std::size_t			m_end = 0;
+		bool				m_failed = false;
+	};
+}	// namespace
+
+namespace CSV
+{
+	RunStore::RunStore(const std::wstring& parent_dir, std::size_t record_size)
+		: m_record_size(record_size)
+	{
+		std::error_code ec;
+		const fs::path parent = parent_dir.empty() ? fs::temp_directory_path(ec) : fs::path(parent_dir);
+		if (ec)
+			return;
+
+		const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+		for (unsigned attempt = 0; attempt < 16; ++attempt)
+		{
+			const fs::path dir = parent / (L"QuickLinx-runs-" + std::to_wstring(stamp) + L"-" + std::to_wstring(attempt));
+			if (fs::create_directory(dir, ec))
+			{
+				m_directory = dir.wstring();
+				return;
+			}
+		}
+	}
+
+	RunStore::~RunStore()
+	{
+		if (!is_open())
+			return;
+
+		std::error_code ec;
+		fs::remove_all(fs::path(m_directory), ec);
+	}
+
+	std::wstring RunStore::next_run_path()
+	{
+		return (fs::path(m_directory) / (L"run-" + std::to_wstring(m_next_id++) + L".bin")).wstring();
+	}
+
+	bool RunStore::add_run(const char* records, std::size_t count)
+	{
+		if (!is_open() || count == 0)
+			return is_open();
+
+		const std::wstring path = next_run_path();
+		std::ofstream file(fs::path(path), std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+			return false;
+
+		file.write(records, static_cast<std::streamsize>(count * m_record_size));
+		file.close();
+		if (!file)
+			return false;
+
+		m_runs.push_back(path);
+		return true;
+	}
+
+	bool RunStore::merge(		std::size_t memory_budget,
+								Less less,
+								const std::function<bool(const char* record)>& visit)
+	{
+		if (!is_open())
+			return false;
+
+		const std::size_t fan_in = std::max<std::size_t>(2, memory_budget / MIN_RUN_BUFFER);
+
+		// Too many runs to buffer at once: merge the oldest into longer runs first
+		while (m_runs.size() > fan_in)
+		{
+			const std::vector<std::wstring> group(m_runs.begin(), m_runs.begin() + fan_in);
+			m_runs.erase(m_runs.begin(), m_runs.begin() + fan_in);
+
+			const std::wstring path = next_run_path();
+			std::ofstream out(fs::path(path), std::ios::binary | std::ios::trunc);
+			if (!out.is_open())
+				return false;
+
+			std::vector<char> pending;
+			pending.reserve(MIN_RUN_BUFFER);
+
+			const bool merged = merge_runs(group, memory_budget / (fan_in + 1), less,
+				[&](const char* record) {
+					pending.insert(pending.end(), record, record + m_record_size);
+					if (pending.size() >= MIN_RUN_BUFFER)
+					{
+						out.write(pending.data(), static_cast<std::streamsize>(pending.size()));
+						pending.clear();
+					}
+					return true;
+				});
+
+			out.write(pending.data(), static_cast<std::streamsize>(pending.size()));
+			out.close();
+			if (!merged || !out)
+				return false;
+
+			std::error_code ec;
+			for (const std::wstring& run : group)
+				fs::remove(fs::path(run), ec);
+
+			m_runs.push_back(path);
+		}
+
+		if (m_runs.empty())
+			return true;
+
+		return merge_runs(m_runs, memory_budget / m_runs.size(), less, visit);
+	}
+
+	bool RunStore::merge_runs(	const std::vector<std::wstring>& runs,
+								std::size_t buffer_bytes,
+								Less less,
+								const std::function<bool(const char* record)>& visit)
+	{
+		buffer_bytes = std::max(buffer_bytes, MIN_RUN_BUFFER);
+
+		std::vector<RunReader> readers;
+		readers.reserve(runs.size());
+		for (const std::wstring& run : runs)
+		{
+			readers.emplace_back(run, m_record_size, buffer_bytes);
+			if (!readers.back().good())
+				return false;
+		}
+
+		// Min-heap of run indices ordered by each run's current record
+		auto greater = [&](std::size_t a, std::size_t b) {
+			return less(readers[b].current(), readers[a].current());
+			};
+		std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(greater)> heap(greater);
+
+		for (std::size_t i = 0; i < readers.size(); ++i)
+		{
+			if (readers[i].current() != nullptr)
+				heap.push(i);
+		}
+
+		while (!heap.empty())
+		{
+			const std::size_t index = heap.top();
+			heap.pop();
+
+			if (!visit(readers[index].current()))
+				return true;
+
+			readers[index].advance();
+			if (readers[index].current() != nullptr)
+				heap.push(index);
+		}
+
+		for (const RunReader& reader : readers)
+		{
+			if (!reader.good())
+				return false;
+		}
+		return true;
+	}
+}	// namespace CSV
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+/*
+	File: CSVRunStore.h
+
+	Desc: Temporary sorted runs for the external merge sort behind
+		  CSV::stream_drivers_from_file.
+
+		  Records are fixed-size blobs. Each run is written already
+		  sorted; merge() then streams every record of every run back in
+		  order through a k-way merge, reading each run through a bounded
+		  buffer. When there are more runs than the memory budget allows
+		  buffers for, groups of runs are merged into longer runs first.
+
+		  The runs live in a private directory under the system (or
+		  given) temp directory, removed when the store is destroyed.
+*/
+
+
+namespace CSV
+{
+	class RunStore
+	{
+	public:
+		using Less = bool (*)(const char* a, const char* b);
+
+		// Creates a private directory under parent_dir (empty = system temp)
+		RunStore(const std::wstring& parent_dir, std::size_t record_size);
+		~RunStore();
+
+		RunStore(const RunStore&) = delete;
+		RunStore& operator=(const RunStore&) = delete;
+
+		bool is_open() const noexcept { return !m_directory.empty(); }
+
+		// Write count records (already sorted by less) as a new run
+		bool add_run(const char* records, std::size_t count);
+
+		// Visit every record of every run in order. visit returns false to stop early.
+		// Returns false only on an I/O error.
+		bool merge(			std::size_t memory_budget,
+							Less less,
+							const std::function<bool(const char* record)>& visit);
+
+	private:
+		std::wstring next_run_path();
+		bool merge_runs(	const std::vector<std::wstring>& runs,
+							std::size_t buffer_bytes,
+							Less less,
+							const std::function<bool(const char* record)>& visit);
+
+		std::wstring				m_directory;
+		std::size_t					m_record_size;
+		std::vector<std::wstring>	m_runs;
+		std::size_t					m_next_id = 0;
+	};
+}
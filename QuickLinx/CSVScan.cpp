@@ -0,0 +1,339 @@
+#include "CSVScan.h"
+
+#include <atomic>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define QLX_SCAN_X86 1
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#define QLX_TARGET_AVX2
+	#else
+		#define QLX_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#endif
+
+namespace
+{
+	using CSV::Scan::Level;
+
+	inline bool is_space(char ch) noexcept
+	{
+		return ch == ' ' || (ch >= '\t' && ch <= '\r');
+	}
+
+	// ----------------------------- Scalar -----------------------------
+
+	const char* find_delimiter_scalar(const char* p, const char* last) noexcept
+	{
+		for (; p < last; ++p)
+		{
+			if (*p == ',' || *p == '\n')
+				return p;
+		}
+		return last;
+	}
+
+	const char* find_newline_scalar(const char* p, const char* last) noexcept
+	{
+		const void* hit = std::memchr(p, '\n', static_cast<std::size_t>(last - p));
+		return hit ? static_cast<const char*>(hit) : last;
+	}
+
+	const char* skip_space_scalar(const char* p, const char* last) noexcept
+	{
+		while (p < last && is_space(*p))
+			++p;
+		return p;
+	}
+
+	const char* skip_space_back_scalar(const char* first, const char* last) noexcept
+	{
+		while (last > first && is_space(last[-1]))
+			--last;
+		return last;
+	}
+
+#if defined(QLX_SCAN_X86)
+
+	inline unsigned lowest_bit(unsigned mask) noexcept
+	{
+	#if defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanForward(&index, mask);
+		return index;
+	#else
+		return static_cast<unsigned>(__builtin_ctz(mask));
+	#endif
+	}
+
+	inline unsigned highest_bit(unsigned mask) noexcept
+	{
+	#if defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanReverse(&index, mask);
+		return index;
+	#else
+		return 31u - static_cast<unsigned>(__builtin_clz(mask));
+	#endif
+	}
+
+	// ------------------------------ SSE2 ------------------------------
+
+	// 0xFF in every lane holding whitespace. Bytes >= 0x80 are negative
+	// as signed chars, so the 9..13 window never matches them.
+	inline __m128i space_mask_sse2(__m128i v) noexcept
+	{
+		const __m128i is_blank = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+		const __m128i is_ctrl = _mm_and_si128(
+			_mm_cmpgt_epi8(v, _mm_set1_epi8('\t' - 1)),
+			_mm_cmplt_epi8(v, _mm_set1_epi8('\r' + 1)));
+		return _mm_or_si128(is_blank, is_ctrl);
+	}
+
+	const char* find_delimiter_sse2(const char* p, const char* last) noexcept
+	{
+		const __m128i comma = _mm_set1_epi8(',');
+		const __m128i newline = _mm_set1_epi8('\n');
+
+		for (; last - p >= 16; p += 16)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+				_mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, newline))));
+			if (mask != 0)
+				return p + lowest_bit(mask);
+		}
+		return find_delimiter_scalar(p, last);
+	}
+
+	const char* find_newline_sse2(const char* p, const char* last) noexcept
+	{
+		const __m128i newline = _mm_set1_epi8('\n');
+
+		for (; last - p >= 16; p += 16)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)));
+			if (mask != 0)
+				return p + lowest_bit(mask);
+		}
+		return find_newline_scalar(p, last);
+	}
+
+	const char* skip_space_sse2(const char* p, const char* last) noexcept
+	{
+		for (; last - p >= 16; p += 16)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			const unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(space_mask_sse2(v))) & 0xFFFFu;
+			if (mask != 0)
+				return p + lowest_bit(mask);
+		}
+		return skip_space_scalar(p, last);
+	}
+
+	const char* skip_space_back_sse2(const char* first, const char* last) noexcept
+	{
+		for (; last - first >= 16; last -= 16)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last - 16));
+			const unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(space_mask_sse2(v))) & 0xFFFFu;
+			if (mask != 0)
+				return last - 16 + highest_bit(mask) + 1;
+		}
+		return skip_space_back_scalar(first, last);
+	}
+
+	// ------------------------------ AVX2 ------------------------------
+
+	QLX_TARGET_AVX2 inline __m256i space_mask_avx2(__m256i v) noexcept
+	{
+		const __m256i is_blank = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+		const __m256i is_ctrl = _mm256_and_si256(
+			_mm256_cmpgt_epi8(v, _mm256_set1_epi8('\t' - 1)),
+			_mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), v));
+		return _mm256_or_si256(is_blank, is_ctrl);
+	}
+
+	QLX_TARGET_AVX2 const char* find_delimiter_avx2(const char* p, const char* last) noexcept
+	{
+		const __m256i comma = _mm256_set1_epi8(',');
+		const __m256i newline = _mm256_set1_epi8('\n');
+
+		for (; last - p >= 32; p += 32)
+		{
+			const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+			const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, comma), _mm256_cmpeq_epi8(v, newline))));
+			if (mask != 0)
+				return p + lowest_bit(mask);
+		}
+		return find_delimiter_sse2(p, last);
+	}
+
+	QLX_TARGET_AVX2 const char* find_newline_avx2(const char* p, const char* last) noexcept
+	{
+		const __m256i newline = _mm256_set1_epi8('\n');
+
+		for (; last - p >= 32; p += 32)
+		{
+			const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+			const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline)));
+			if (mask != 0)
+				return p + lowest_bit(mask);
+		}
+		return find_newline_sse2(p, last);
+	}
+
+	QLX_TARGET_AVX2 const char* skip_space_avx2(const char* p, const char* last) noexcept
+	{
+		for (; last - p >= 32; p += 32)
+		{
+			const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+			const unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(space_mask_avx2(v)));
+			if (mask != 0)
+				return p + lowest_bit(mask);
+		}
+		return skip_space_sse2(p, last);
+	}
+
+	QLX_TARGET_AVX2 const char* skip_space_back_avx2(const char* first, const char* last) noexcept
+	{
+		for (; last - first >= 32; last -= 32)
+		{
+			const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(last - 32));
+			const unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(space_mask_avx2(v)));
+			if (mask != 0)
+				return last - 32 + highest_bit(mask) + 1;
+		}
+		return skip_space_back_sse2(first, last);
+	}
+
+	// Checks CPU and OS support (YMM state enabled) for AVX2
+	bool cpu_has_avx2() noexcept
+	{
+	#if defined(_MSC_VER)
+		int info[4] = {};
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx)
+			return false;
+
+		if ((_xgetbv(0) & 0x6) != 0x6)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+	#else
+		return __builtin_cpu_supports("avx2") != 0;
+	#endif
+	}
+
+#endif	// QLX_SCAN_X86
+
+	struct Kernels
+	{
+		Level level;
+		const char* (*find_delimiter)(const char*, const char*) noexcept;
+		const char* (*find_newline)(const char*, const char*) noexcept;
+		const char* (*skip_space)(const char*, const char*) noexcept;
+		const char* (*skip_space_back)(const char*, const char*) noexcept;
+	};
+
+	const Kernels SCALAR_KERNELS = {
+		Level::Scalar, find_delimiter_scalar, find_newline_scalar, skip_space_scalar, skip_space_back_scalar };
+
+#if defined(QLX_SCAN_X86)
+	const Kernels SSE2_KERNELS = {
+		Level::SSE2, find_delimiter_sse2, find_newline_sse2, skip_space_sse2, skip_space_back_sse2 };
+
+	const Kernels AVX2_KERNELS = {
+		Level::AVX2, find_delimiter_avx2, find_newline_avx2, skip_space_avx2, skip_space_back_avx2 };
+#endif
+
+	// Widest kernel set the running CPU supports (SSE2 is baseline on x64)
+	Level detect_level() noexcept
+	{
+	#if defined(QLX_SCAN_X86)
+		static const Level detected = cpu_has_avx2() ? Level::AVX2 : Level::SSE2;
+		return detected;
+	#else
+		return Level::Scalar;
+	#endif
+	}
+
+	const Kernels* kernels_for(Level level) noexcept
+	{
+		if (level > detect_level())
+			level = detect_level();
+
+	#if defined(QLX_SCAN_X86)
+		if (level == Level::AVX2)
+			return &AVX2_KERNELS;
+		if (level == Level::SSE2)
+			return &SSE2_KERNELS;
+	#endif
+		return &SCALAR_KERNELS;
+	}
+
+	std::atomic<const Kernels*> g_kernels{ nullptr };
+
+	const Kernels& kernels() noexcept
+	{
+		const Kernels* k = g_kernels.load(std::memory_order_relaxed);
+		if (k == nullptr)
+		{
+			k = kernels_for(detect_level());
+			g_kernels.store(k, std::memory_order_relaxed);
+		}
+		return *k;
+	}
+}	// namespace
+
+namespace CSV
+{
+	namespace Scan
+	{
+		Level active_level() noexcept
+		{
+			return kernels().level;
+		}
+
+		void set_level(Level level) noexcept
+		{
+			g_kernels.store(kernels_for(level), std::memory_order_relaxed);
+		}
+
+		const char* find_delimiter(const char* first, const char* last) noexcept
+		{
+			return kernels().find_delimiter(first, last);
+		}
+
+		const char* find_newline(const char* first, const char* last) noexcept
+		{
+			return kernels().find_newline(first, last);
+		}
+
+		const char* skip_space(const char* first, const char* last) noexcept
+		{
+			// Most fields have no padding; avoid the kernel call entirely
+			if (first == last || !is_space(*first))
+				return first;
+			return kernels().skip_space(first, last);
+		}
+
+		const char* skip_space_back(const char* first, const char* last) noexcept
+		{
+			if (first == last || !is_space(last[-1]))
+				return last;
+			return kernels().skip_space_back(first, last);
+		}
+	}
+}	// namespace CSV
@@ -0,0 +1,48 @@
+#pragma once
+
+/*
+	File: CSVScan.h
+
+	Desc: Byte scanning kernels used by the CSV tokenizer.
+
+		  Finds ',' / '\n' delimiters and skips ASCII whitespace in
+		  16-byte (SSE2) or 32-byte (AVX2) blocks. The widest kernel the
+		  CPU supports is picked once at runtime, with a scalar fallback
+		  for other targets.
+
+		  Whitespace is the set iswspace() accepts in the "C" locale:
+		  space, \t, \n, \v, \f and \r.
+*/
+
+
+namespace CSV
+{
+	namespace Scan
+	{
+		enum class Level
+		{
+			Scalar,
+			SSE2,
+			AVX2
+		};
+
+		// Kernel set currently in use
+		Level active_level() noexcept;
+
+		// Override the detected kernel set (clamped to what the CPU supports).
+		// Intended for profiling the scalar path against the vector ones.
+		void set_level(Level level) noexcept;
+
+		// First ',' or '\n' in [first, last), or last if there is none
+		const char* find_delimiter(const char* first, const char* last) noexcept;
+
+		// First '\n' in [first, last), or last if there is none
+		const char* find_newline(const char* first, const char* last) noexcept;
+
+		// First non-whitespace byte in [first, last), or last
+		const char* skip_space(const char* first, const char* last) noexcept;
+
+		// One past the last non-whitespace byte in [first, last), or first
+		const char* skip_space_back(const char* first, const char* last) noexcept;
+	}
+}
@@ -0,0 +1,57 @@
+#include "CSVTokenizer.h"
+#include "CSVScan.h"
+
+namespace
+{
+	// Slice [first, last) with whitespace trimmed from both ends
+	inline std::string_view trimmed(const char* first, const char* last) noexcept
+	{
+		first = CSV::Scan::skip_space(first, last);
+		last = CSV::Scan::skip_space_back(first, last);
+		return std::string_view(first, static_cast<std::size_t>(last - first));
+	}
+}	// namespace
+
+namespace CSV
+{
+	std::string_view trim_view(std::string_view s) noexcept
+	{
+		return trimmed(s.data(), s.data() + s.size());
+	}
+
+	std::size_t Tokenizer::next_row(	std::string_view* cols_out,
+										std::size_t max_cols) noexcept
+	{
+		if (m_pos >= m_data.size())
+			return 0;
+
+		const char* p = m_data.data() + m_pos;
+		const char* end = m_data.data() + m_data.size();
+		std::size_t count = 0;
+
+		while (true)
+		{
+			const char* hit = Scan::find_delimiter(p, end);
+
+			// '\r' before '\n' is whitespace, so trimming also folds "\r\n"
+			if (count < max_cols)
+				cols_out[count] = trimmed(p, hit);
+			++count;
+
+			if (hit == end)
+			{
+				m_pos = m_data.size();
+				break;
+			}
+
+			p = hit + 1;
+			if (*hit == '\n')
+			{
+				m_pos = static_cast<std::size_t>(p - m_data.data());
+				break;
+			}
+		}
+
+		return count;
+	}
+}	// namespace CSV
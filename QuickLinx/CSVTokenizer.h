@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string_view>
+#include <cstddef>
+
+/*
+	File: CSVTokenizer.h
+
+	Desc: Zero-copy tokenizer over raw CSV bytes (usually a MappedFile view).
+
+		  Lines and columns are handed out as std::string_view slices into
+		  the original buffer. Nothing is allocated; callers copy a slice
+		  only when they materialize an EthDriver or an error message.
+
+		  Delimiter search and trimming run on the vector kernels in
+		  CSVScan.h.
+*/
+
+
+namespace CSV
+{
+	// Trim leading/trailing whitespace (space, \t, \n, \v, \f, \r) from a slice
+	std::string_view trim_view(std::string_view s) noexcept;
+
+	class Tokenizer
+	{
+	public:
+		explicit Tokenizer(std::string_view data) noexcept
+			: m_data(data)
+		{}
+
+		// Next line split on ',' into trimmed slices (no quote handling), in one
+		// scan over the bytes. Writes at most max_cols slices and returns the
+		// total column count, or 0 once the input is exhausted.
+		// A blank line comes back as a single empty column.
+		std::size_t next_row(			std::string_view* cols_out,
+										std::size_t max_cols) noexcept;
+
+		// Byte offset of the next unread line
+		std::size_t position() const noexcept { return m_pos; }
+
+	private:
+		std::string_view	m_data;
+		std::size_t			m_pos = 0;
+	};
+}
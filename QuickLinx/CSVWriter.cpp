@@ -0,0 +1,215 @@
+#include "CSVWriter.h"
+
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+	// Decimal text of one octet followed by '.', e.g. "192." (length 4)
+	struct OctetText
+	{
+		char			text[4];
+		std::uint8_t	length;		// digits + dot
+	};
+
+	constexpr std::array<OctetText, 256> make_octet_table() noexcept
+	{
+		std::array<OctetText, 256> table = {};
+		for (unsigned value = 0; value < table.size(); ++value)
+		{
+			OctetText& entry = table[value];
+			std::uint8_t len = 0;
+			if (value >= 100)
+				entry.text[len++] = static_cast<char>('0' + value / 100);
+			if (value >= 10)
+				entry.text[len++] = static_cast<char>('0' + (value / 10) % 10);
+			entry.text[len++] = static_cast<char>('0' + value % 10);
+			entry.text[len++] = '.';
+			entry.length = len;
+		}
+		return table;
+	}
+
+	constexpr std::array<OctetText, 256> OCTETS = make_octet_table();
+
+	// Longest "a.b.c.d-e" plus slack for the 4-byte table copies
+	constexpr std::size_t MAX_RANGE_TEXT = 15 + 1 + 3 + 4;
+
+	// Append "a.b.c.d" at out; returns the end. Needs 16 bytes of room.
+	inline char* put_address(char* out, std::uint32_t address) noexcept
+	{
+		for (int shift = 24; shift > 0; shift -= 8)
+		{
+			const OctetText& octet = OCTETS[(address >> shift) & 0xFF];
+			std::memcpy(out, octet.text, 4);
+			out += octet.length;
+		}
+
+		const OctetText& last = OCTETS[address & 0xFF];
+		std::memcpy(out, last.text, 4);
+		return out + last.length - 1;
+	}
+}	// namespace
+
+namespace CSV
+{
+	Writer::Writer(std::size_t buffer_size)
+		: m_buffer(std::max<std::size_t>(buffer_size, 64), '\0')
+	{}
+
+	Writer::~Writer()
+	{
+		if (is_open())
+			close();
+	}
+
+	bool Writer::open(const std::wstring& path)
+	{
+		if (is_open())
+			close();
+
+		m_used = 0;
+		m_written = 0;
+		m_failed = false;
+
+		// Blocks are already large; skip the stream's own buffering
+		m_file.rdbuf()->pubsetbuf(nullptr, 0);
+		m_file.open(std::filesystem::path(path), std::ios::binary | std::ios::trunc);
+		return m_file.is_open();
+	}
+
+	bool Writer::close()
+	{
+		flush();
+		m_file.close();
+		if (m_file.fail())
+			m_failed = true;
+		return good();
+	}
+
+	bool Writer::flush()
+	{
+		if (!is_open())
+			return good();
+
+		if (m_used != 0)
+		{
+			m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+			m_written += m_used;
+			m_used = 0;
+			if (!m_file)
+				m_failed = true;
+		}
+		return good();
+	}
+
+	void Writer::make_room(std::size_t n)
+	{
+		if (is_open())
+		{
+			flush();
+			if (m_buffer.size() >= n)
+				return;
+		}
+
+		m_buffer.resize(std::max(m_buffer.size() * 2, m_used + n));
+	}
+
+	void Writer::text(std::string_view utf8)
+	{
+		// A block larger than the buffer goes straight to the file
+		if (is_open() && utf8.size() >= m_buffer.size())
+		{
+			flush();
+			m_file.write(utf8.data(), static_cast<std::streamsize>(utf8.size()));
+			m_written += utf8.size();
+			if (!m_file)
+				m_failed = true;
+			return;
+		}
+
+		reserve(utf8.size());
+		std::memcpy(&m_buffer[m_used], utf8.data(), utf8.size());
+		m_used += utf8.size();
+	}
+
+	void Writer::text(std::wstring_view text)
+	{
+		// At most 4 UTF-8 bytes per wchar_t (UTF-16 on Windows, UTF-32 elsewhere)
+		reserve(text.size() * 4);
+		char* out = &m_buffer[m_used];
+
+		for (std::size_t i = 0; i < text.size(); ++i)
+		{
+			std::uint32_t cp = static_cast<std::uint32_t>(text[i]);
+			if (cp < 0x80)
+			{
+				*out++ = static_cast<char>(cp);
+				continue;
+			}
+
+			if (cp >= 0xD800 && cp <= 0xDFFF)
+			{
+				// UTF-16 surrogate pair; a lone half becomes U+FFFD
+				const std::uint32_t low = (i + 1 < text.size()) ? static_cast<std::uint32_t>(text[i + 1]) : 0;
+				if (cp <= 0xDBFF && low >= 0xDC00 && low <= 0xDFFF)
+				{
+					cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+					++i;
+				}
+				else
+				{
+					cp = 0xFFFD;
+				}
+			}
+			else if (cp > 0x10FFFF)
+			{
+				cp = 0xFFFD;
+			}
+
+			if (cp < 0x800)
+			{
+				*out++ = static_cast<char>(0xC0 | (cp >> 6));
+				*out++ = static_cast<char>(0x80 | (cp & 0x3F));
+			}
+			else if (cp < 0x10000)
+			{
+				*out++ = static_cast<char>(0xE0 | (cp >> 12));
+				*out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+				*out++ = static_cast<char>(0x80 | (cp & 0x3F));
+			}
+			else
+			{
+				*out++ = static_cast<char>(0xF0 | (cp >> 18));
+				*out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+				*out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+				*out++ = static_cast<char>(0x80 | (cp & 0x3F));
+			}
+		}
+
+		m_used = static_cast<std::size_t>(out - m_buffer.data());
+	}
+
+	void Writer::address(std::uint32_t address)
+	{
+		reserve(MAX_RANGE_TEXT);
+		char* out = put_address(&m_buffer[m_used], address);
+		m_used = static_cast<std::size_t>(out - m_buffer.data());
+	}
+
+	void Writer::range(const IPv4::Range& range)
+	{
+		reserve(MAX_RANGE_TEXT);
+		char* out = put_address(&m_buffer[m_used], range.first);
+		if (range.last != range.first)
+		{
+			const OctetText& last = OCTETS[range.last & 0xFF];
+			*out++ = '-';
+			std::memcpy(out, last.text, 4);
+			out += last.length - 1;
+		}
+		m_used = static_cast<std::size_t>(out - m_buffer.data());
+	}
+}	// namespace CSV
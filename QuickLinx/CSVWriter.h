@@ -1 +1,96 @@
 #pragma once
+
+#include "IPv4.h"
+
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <cstddef>
+#include <cstdint>
+
+/*
+	File: CSVWriter.h
+
+	Desc: Buffered UTF-8 CSV writer used by every export path.
+
+		  Output is assembled in one large reusable byte buffer and
+		  handed to the file in big blocks. Wide text is transcoded to
+		  UTF-8 on the way in, and IPv4 addresses are formatted from a
+		  precomputed table of octet strings instead of going through
+		  stream formatting.
+
+		  With no file open the buffer simply grows, so a Writer can
+		  also format rows in memory for a caller to write later.
+*/
+
+
+namespace CSV
+{
+	class Writer
+	{
+	public:
+		static constexpr std::size_t DEFAULT_BUFFER_SIZE = std::size_t(1) << 20;	// 1 MB
+
+		explicit Writer(std::size_t buffer_size = DEFAULT_BUFFER_SIZE);
+		~Writer();
+
+		Writer(const Writer&) = delete;
+		Writer& operator=(const Writer&) = delete;
+
+		// Create (or truncate) path and write to it from now on
+		bool open(const std::wstring& path);
+
+		// Flush what is buffered and close the file. Returns false if any write failed.
+		bool close();
+
+		bool is_open() const { return m_file.is_open(); }
+		bool good() const noexcept { return !m_failed; }
+
+		// Raw UTF-8 bytes
+		void text(std::string_view utf8);
+
+		// Wide text, transcoded to UTF-8
+		void text(std::wstring_view text);
+
+		// "a.b.c.d"
+		void address(std::uint32_t address);
+
+		// "a.b.c.d" or "a.b.c.d-e" (ranges never cross a /24)
+		void range(const IPv4::Range& range);
+
+		void separator() { put(','); }
+		void end_row() { text(std::string_view("\r\n", 2)); }
+
+		// Bytes not yet written to the file (everything, when no file is open)
+		std::string_view buffered() const noexcept { return std::string_view(m_buffer.data(), m_used); }
+		void clear() noexcept { m_used = 0; }
+
+		// Bytes written so far, buffered or not (the file offset of the next byte)
+		std::uint64_t position() const noexcept { return m_written + m_used; }
+
+		// Write the buffer to the file
+		bool flush();
+
+	private:
+		void put(char c)
+		{
+			reserve(1);
+			m_buffer[m_used++] = c;
+		}
+
+		// Make room for n more bytes (flushing first when a file is open)
+		void reserve(std::size_t n)
+		{
+			if (m_buffer.size() - m_used < n)
+				make_room(n);
+		}
+
+		void make_room(std::size_t n);
+
+		std::string		m_buffer;
+		std::size_t		m_used = 0;
+		std::uint64_t	m_written = 0;		// bytes already handed to the file
+		std::ofstream	m_file;
+		bool			m_failed = false;
+	};
+}
@@ -0,0 +1,169 @@
+#include "Diagnostics.h"
+#include "IPv4.h"
+
+namespace Diagnostics
+{
+	List::List(std::size_t limit)
+		: m_limit(limit == 0 ? 1 : limit)
+	{}
+
+	std::uint32_t List::intern(std::wstring_view s)
+	{
+		m_spans.push_back({ static_cast<std::uint32_t>(m_pool.size()), static_cast<std::uint32_t>(s.size()) });
+		m_pool.append(s.data(), s.size());
+		return static_cast<std::uint32_t>(m_spans.size() - 1);
+	}
+
+	bool List::add(		Code code,
+						std::uint32_t line,
+						std::uint8_t column,
+						std::wstring_view driver,
+						std::wstring_view text,
+						std::uint32_t value,
+						std::wstring_view source)
+	{
+		if (full())
+		{
+			m_truncated = true;
+			return false;
+		}
+
+		Record record;
+		record.code = code;
+		record.column = column;
+		record.line = line;
+		record.driver = driver.empty() ? NO_TEXT : intern(driver);
+		record.text = text.empty() ? NO_TEXT : intern(text);
+		record.value = value;
+		record.source = source.empty() ? NO_TEXT : intern(source);
+		m_records.push_back(record);
+		return true;
+	}
+
+	bool List::add(		const List& other,
+						std::size_t index,
+						std::wstring_view source)
+	{
+		const Record& record = other[index];
+		return add(record.code, record.line, record.column,
+			other.text(record.driver), other.text(record.text), record.value,
+			source.empty() ? other.text(record.source) : source);
+	}
+
+	std::wstring_view List::text(std::uint32_t id) const
+	{
+		if (id >= m_spans.size())
+			return {};
+		return std::wstring_view(m_pool).substr(m_spans[id].offset, m_spans[id].length);
+	}
+
+	std::wstring List::format(std::size_t index) const
+	{
+		const Record& record = m_records[index];
+		if (record.source != NO_TEXT)
+			return std::wstring(text(record.source)) + L": " + format_message(record);
+		return format_message(record);
+	}
+
+	std::wstring List::format_message(const Record& record) const
+	{
+		const std::wstring line = L"Line " + std::to_wstring(record.line);
+		const std::wstring driver(text(record.driver));
+		const std::wstring detail(text(record.text));
+
+		switch (record.code)
+		{
+		case Code::ColumnCount:
+			return line + L": expected 3 columns (Type,Name,Range).";
+		case Code::UnsupportedType:
+			return line + L": unsupported Type \"" + detail + L"\". "
+						L"Expected \"AB_ETH\".";
+		case Code::EmptyName:
+			return line + L": Name field is empty.";
+		case Code::NameTooLong:
+			return line + L": driver name \"" + detail +
+						L"\" exceeds 15-character limit.";
+		case Code::EmptyRange:
+			return line + L": Range field is empty.";
+		case Code::BadRange:
+			return line + L": IP range \"" + detail +
+						L"\" did not produce any addresses.";
+		case Code::BadRangeAddress:
+			return line + L": \"" + detail +
+						L"\" is not a valid IPv4 address.";
+		case Code::BadAddress:
+			return line + L": Range \"" + detail +
+						L"\" is neither a valid IPv4 address "
+						L"nor a valid range.";
+		case Code::DuplicateNode:
+			return line + L": duplicate node IP \"" + IPv4::to_wstring(record.value) +
+						L"\" for driver \"" + driver + L"\".";
+		case Code::NodeLimit:
+			return L"Driver \"" + driver +
+						L"\" exceeds maximum of 254 nodes. "
+						L"Limit reached while processing line " +
+						std::to_wstring(record.line) + L".";
+
+		case Code::OpenFailed:
+			return L"Failed to open CSV file: " + detail;
+		case Code::EmptyFile:
+			return L"CSV file is empty.";
+		case Code::HeaderColumns:
+			return L"CSV header is invalid. Expected: Type,Name,Range";
+		case Code::HeaderNames:
+			return L"CSV header must be: Type,Name,Range";
+		case Code::TempDirectoryFailed:
+			return L"Failed to create temporary directory for streaming import.";
+		case Code::TempWriteFailed:
+			return L"Failed to write temporary file for streaming import.";
+		case Code::TempReadFailed:
+			return L"Failed to read temporary file for streaming import.";
+
+		case Code::NoDriversToMerge:
+			return L"No drivers found in CSV import.";
+		case Code::NoDriversToOverwrite:
+			return L"Overwrite failed. No drivers found in CSV import.";
+		case Code::MergeNodeLimit:
+			return L"Driver '" + driver + L"' (" + detail +
+						L") has reached maximum node limit. Extra nodes were skipped.";
+
+		case Code::DuplicateDriver:
+			return L"Driver \"" + driver + L"\" is also defined in " + detail + L".";
+		case Code::CombinedNodeLimit:
+			return L"Driver \"" + driver + L"\" exceeds maximum of 254 nodes "
+						L"after combining files.";
+
+		case Code::PatchColumnCount:
+			return line + L": expected 4 columns (Op,Type,Name,Range).";
+		case Code::PatchHeader:
+			return L"Patch header must be: Op,Type,Name,Range";
+		case Code::UnsupportedOp:
+			return line + L": unsupported Op \"" + detail + L"\". "
+						L"Expected \"+\" or \"-\".";
+		}
+		return line + L": invalid line.";
+	}
+
+	std::wstring List::format_all() const
+	{
+		std::wstring out;
+		for (std::size_t i = 0; i < m_records.size(); ++i)
+		{
+			out += format(i);
+			out += L'\n';
+		}
+
+		if (m_truncated)
+			out += L"Stopped after " + std::to_wstring(m_records.size()) + L" errors.\n";
+
+		return out;
+	}
+
+	void List::clear()
+	{
+		m_truncated = false;
+		m_records.clear();
+		m_spans.clear();
+		m_pool.clear();
+	}
+}
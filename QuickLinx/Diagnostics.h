@@ -0,0 +1,145 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/*
+	File: Diagnostics.h
+
+	Description:
+		Compact error records shared by the CSV reader and ImportEngine.
+
+		Each problem is stored as a small fixed-size Record: an error code,
+		the line and CSV column it was found on, and references into a
+		shared string pool for the driver name and the offending text.
+		Nothing is formatted until a message is actually displayed.
+
+		A List holds at most limit() records; once full, add() refuses
+		further records and marks the list truncated so callers can stop
+		early.
+*/
+
+namespace Diagnostics
+{
+	enum class Code : std::uint8_t
+	{
+		// CSV rows
+		ColumnCount,			// wrong number of columns
+		UnsupportedType,		// text = Type field
+		EmptyName,
+		NameTooLong,			// text = Name field
+		EmptyRange,
+		BadRange,				// text = Range field
+		BadRangeAddress,		// text = a.b.c part of the range
+		BadAddress,				// text = Range field
+		DuplicateNode,			// value = IPv4 address, driver
+		NodeLimit,				// driver
+
+		// CSV files
+		OpenFailed,				// text = path
+		EmptyFile,
+		HeaderColumns,
+		HeaderNames,
+		TempDirectoryFailed,
+		TempWriteFailed,
+		TempReadFailed,
+
+		// ImportEngine
+		NoDriversToMerge,
+		NoDriversToOverwrite,
+		MergeNodeLimit,			// driver, text = key name
+
+		// Multi-file CSV import
+		DuplicateDriver,		// driver, text = file it was first seen in
+		CombinedNodeLimit,		// driver
+
+		// Patch CSV
+		PatchColumnCount,		// wrong number of columns
+		PatchHeader,
+		UnsupportedOp			// text = Op field
+	};
+
+	// CSV columns for Record::column
+	constexpr std::uint8_t COLUMN_NONE	= 0;
+	constexpr std::uint8_t COLUMN_TYPE	= 1;
+	constexpr std::uint8_t COLUMN_NAME	= 2;
+	constexpr std::uint8_t COLUMN_RANGE	= 3;
+
+	constexpr std::uint32_t NO_TEXT = 0xFFFFFFFF;
+
+	struct Record
+	{
+		Code			code = Code::ColumnCount;
+		std::uint8_t	column = COLUMN_NONE;
+		std::uint32_t	line = 0;				// 1-based file line, 0 if not tied to a line
+		std::uint32_t	driver = NO_TEXT;		// string id of the driver name
+		std::uint32_t	text = NO_TEXT;			// string id of the offending text
+		std::uint32_t	value = 0;				// numeric detail (see Code)
+		std::uint32_t	source = NO_TEXT;		// string id of the file, when several are read
+	};
+
+	class List
+	{
+	public:
+		static constexpr std::size_t DEFAULT_LIMIT = 100;
+
+		explicit List(std::size_t limit = DEFAULT_LIMIT);
+
+		// Record a problem. Returns false (and marks the list truncated)
+		// once limit() records are held. Empty strings are not pooled;
+		// their ids are NO_TEXT.
+		bool add(			Code code,
+							std::uint32_t line = 0,
+							std::uint8_t column = COLUMN_NONE,
+							std::wstring_view driver = {},
+							std::wstring_view text = {},
+							std::uint32_t value = 0,
+							std::wstring_view source = {});
+
+		// Copy one record from another list, text included. A non-empty
+		// source replaces the record's source file.
+		bool add(			const List& other,
+							std::size_t index,
+							std::wstring_view source = {});
+
+		bool empty() const noexcept { return m_records.empty(); }
+		bool full() const noexcept { return m_records.size() >= m_limit; }
+		bool truncated() const noexcept { return m_truncated; }
+		std::size_t size() const noexcept { return m_records.size(); }
+		std::size_t limit() const noexcept { return m_limit; }
+
+		const Record& operator[](std::size_t index) const { return m_records[index]; }
+		std::vector<Record>::const_iterator begin() const noexcept { return m_records.begin(); }
+		std::vector<Record>::const_iterator end() const noexcept { return m_records.end(); }
+
+		// Text behind a string id (empty for NO_TEXT)
+		std::wstring_view text(std::uint32_t id) const;
+
+		// Message for one record, prefixed with its source file if it has one
+		std::wstring format(std::size_t index) const;
+
+		// Every message, one per line, noting when the list was truncated
+		std::wstring format_all() const;
+
+		void clear();
+
+	private:
+		std::uint32_t intern(std::wstring_view s);
+		std::wstring format_message(const Record& record) const;
+
+		struct Span
+		{
+			std::uint32_t	offset;
+			std::uint32_t	length;
+		};
+
+		std::size_t				m_limit;
+		bool					m_truncated = false;
+		std::vector<Record>		m_records;
+		std::vector<Span>		m_spans;		// string id -> slice of m_pool
+		std::wstring			m_pool;
+	};
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "IPv4.h"
+#include "NodeList.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cwctype>
+
+/*
+	File: DriverFilter.h
+
+	Description:
+		Selects which drivers an export includes, e.g. every driver whose
+		name matches "SITE-42*" or that has a node in 10.20.0.0/16.
+
+		RegistryManager evaluates the filter while enumerating: the name
+		is checked as soon as the driver's Name value is read, so rejected
+		drivers never have their Node Table opened.
+
+		An empty filter matches every driver. parse() builds one from the
+		text a user types (the export options in the main window).
+*/
+
+struct DriverFilter {
+
+	std::wstring				name_glob;				// '*' and '?' wildcards, case-insensitive (empty = any name)
+	std::vector<IPv4::Subnet>	subnets;				// Driver needs a node in at least one (empty = any nodes)
+
+	bool is_empty() const noexcept
+	{
+		return name_glob.empty() && subnets.empty();
+	}
+
+	// Build a filter from a name glob and a list of subnets ("a.b.c.d/n")
+	// separated by commas, semicolons or spaces. Surrounding whitespace is
+	// ignored. Returns false, with a message in error_out, if a subnet does
+	// not parse; filter_out is then left unchanged.
+	static bool parse(		std::wstring_view name_glob,
+							std::wstring_view subnet_list,
+							DriverFilter& filter_out,
+							std::wstring& error_out)
+	{
+		DriverFilter filter;
+		filter.name_glob = std::wstring(IPv4::detail::trim(name_glob));
+
+		auto is_separator = [](wchar_t ch) { return ch == L',' || ch == L';' || std::iswspace(ch); };
+
+		std::size_t at = 0;
+		while (at < subnet_list.size())
+		{
+			if (is_separator(subnet_list[at]))
+			{
+				++at;
+				continue;
+			}
+
+			std::size_t end = at;
+			while (end < subnet_list.size() && !is_separator(subnet_list[end]))
+				++end;
+
+			const std::wstring_view item = subnet_list.substr(at, end - at);
+			IPv4::Subnet subnet;
+			if (IPv4::parse_subnet(item, subnet) != IPv4::ParseError::None)
+			{
+				error_out = L"\"" + std::wstring(item) + L"\" is not a valid subnet. Expected a.b.c.d/n, e.g. 10.20.0.0/16.";
+				return false;
+			}
+
+			filter.subnets.push_back(subnet);
+			at = end;
+		}
+
+		filter_out = std::move(filter);
+		return true;
+	}
+
+	bool matches_name(std::wstring_view name) const noexcept
+	{
+		if (name_glob.empty())
+			return true;
+
+		// Greedy wildcard match; on a mismatch, let the last '*' absorb one more character
+		const std::wstring_view glob(name_glob);
+		std::size_t g = 0;
+		std::size_t n = 0;
+		std::size_t star = std::wstring_view::npos;
+		std::size_t star_n = 0;
+
+		while (n < name.size())
+		{
+			if (g < glob.size() && glob[g] == L'*')
+			{
+				star = g++;
+				star_n = n;
+			}
+			else if (g < glob.size() && (glob[g] == L'?' || std::towupper(glob[g]) == std::towupper(name[n])))
+			{
+				++g;
+				++n;
+			}
+			else if (star != std::wstring_view::npos)
+			{
+				g = star + 1;
+				n = ++star_n;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		while (g < glob.size() && glob[g] == L'*')
+			++g;
+		return g == glob.size();
+	}
+
+	bool matches_nodes(const NodeList& nodes) const noexcept
+	{
+		if (subnets.empty())
+			return true;
+
+		for (const std::uint32_t address : nodes)
+		{
+			for (const IPv4::Subnet& subnet : subnets)
+			{
+				if (subnet.contains(address))
+					return true;
+			}
+		}
+		return false;
+	}
+
+};
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/*
+	File: DriverName.h
+
+	Description:
+		A driver's "Name" value or its AB_ETH-x key name, stored inline.
+		RSLinx allows at most 15 characters in a driver name (the CSV
+		import enforces the same limit) and key names are shorter still,
+		so the text, a case-folded copy and the hash all fit in one
+		fixed block.
+
+		The registry itself has no such limit, so a longer name (typed
+		into regedit, or written by another tool) is kept in one heap
+		block instead of being dropped: the driver still loads, shows up
+		and keeps its AB_ETH-x key, so nothing else is saved over it.
+
+		The hash is computed once on assignment, from the folded text, so
+		hashed lookups never touch the characters and names that differ
+		only in case hash alike. Both inline buffers are zero-padded past
+		the end of the text, which lets equality compare the whole arrays
+		without a length-dependent loop.
+
+		Case folding is ASCII only, the same rule RegFile uses for key
+		names.
+*/
+
+class DriverName {
+
+public:
+	static constexpr std::size_t CAPACITY = 15;			// Longest driver name RSLinx accepts (and that is stored inline)
+
+	DriverName() noexcept = default;
+
+	explicit DriverName(std::wstring_view text) { set(text); }
+
+	DriverName(const DriverName& other) { copy(other); }
+	DriverName(DriverName&& other) noexcept { take(other); }
+
+	DriverName& operator=(const DriverName& other)
+	{
+		if (this != &other)
+			copy(other);
+		return *this;
+	}
+
+	DriverName& operator=(DriverName&& other) noexcept
+	{
+		if (this != &other)
+			take(other);
+		return *this;
+	}
+
+	// Whether text is within the RSLinx limit (longer names are still stored)
+	static constexpr bool fits(std::wstring_view text) noexcept { return text.size() <= CAPACITY; }
+
+	void assign(std::wstring_view text) { set(text); }
+
+	void clear() noexcept { reset(); }
+
+	std::size_t size() const noexcept { return m_length; }
+	bool empty() const noexcept { return m_length == 0; }
+
+	const wchar_t* c_str() const noexcept { return m_long ? m_long.get() : m_text; }
+	std::wstring_view view() const noexcept { return std::wstring_view(c_str(), m_length); }
+	std::wstring_view folded() const noexcept { return std::wstring_view(m_long ? m_long.get() + m_length + 1 : m_folded, m_length); }
+	std::wstring str() const { return std::wstring(view()); }
+
+	operator std::wstring_view() const noexcept { return view(); }
+
+	// Hash of the folded text (see std::hash<DriverName> below)
+	std::size_t hash() const noexcept { return m_hash; }
+
+	// Names of equal length are either both inline or both on the heap
+	bool operator==(const DriverName& other) const noexcept
+	{
+		if (m_hash != other.m_hash || m_length != other.m_length)
+			return false;
+		return m_long ? view() == other.view() : std::memcmp(m_text, other.m_text, sizeof(m_text)) == 0;
+	}
+
+	bool operator!=(const DriverName& other) const noexcept { return !(*this == other); }
+
+	bool iequals(const DriverName& other) const noexcept
+	{
+		if (m_hash != other.m_hash || m_length != other.m_length)
+			return false;
+		return m_long ? folded() == other.folded() : std::memcmp(m_folded, other.m_folded, sizeof(m_folded)) == 0;
+	}
+
+	bool operator<(const DriverName& other) const noexcept { return view() < other.view(); }
+
+	// For unordered containers keyed case-insensitively (with std::hash<DriverName>)
+	struct CaseInsensitiveEqual
+	{
+		bool operator()(const DriverName& a, const DriverName& b) const noexcept { return a.iequals(b); }
+	};
+
+private:
+	static constexpr wchar_t fold(wchar_t c) noexcept
+	{
+		return (c >= L'A' && c <= L'Z') ? static_cast<wchar_t>(c + (L'a' - L'A')) : c;
+	}
+
+	static constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull;		// FNV-1a
+	static constexpr std::uint64_t FNV_PRIME = 1099511628211ull;
+
+	// text may be this name's own view, so the old storage goes last
+	void set(std::wstring_view text)
+	{
+		// Over CAPACITY: text, L'\0', folded text, L'\0' in one (zeroed) block
+		std::unique_ptr<wchar_t[]> block;
+		wchar_t* out_text = m_text;
+		wchar_t* out_folded = m_folded;
+		if (text.size() > CAPACITY)
+		{
+			block = std::make_unique<wchar_t[]>(2 * (text.size() + 1));
+			out_text = block.get();
+			out_folded = out_text + text.size() + 1;
+		}
+
+		std::uint64_t hash = FNV_OFFSET;
+		for (std::size_t i = 0; i < text.size(); ++i)
+		{
+			out_text[i] = text[i];
+			out_folded[i] = fold(text[i]);
+			hash = (hash ^ static_cast<std::uint64_t>(out_folded[i])) * FNV_PRIME;
+		}
+
+		const std::size_t inline_length = block ? 0 : text.size();
+		for (std::size_t i = inline_length; i <= CAPACITY; ++i)
+		{
+			m_text[i] = L'\0';
+			m_folded[i] = L'\0';
+		}
+
+		m_long = std::move(block);
+		m_length = static_cast<std::uint32_t>(text.size());
+		m_hash = static_cast<std::size_t>(hash);
+	}
+
+	void copy(const DriverName& other)
+	{
+		if (other.m_long)
+		{
+			set(other.view());
+			return;
+		}
+
+		m_long.reset();
+		m_hash = other.m_hash;
+		m_length = other.m_length;
+		std::memcpy(m_text, other.m_text, sizeof(m_text));
+		std::memcpy(m_folded, other.m_folded, sizeof(m_folded));
+	}
+
+	// Leaves other empty
+	void take(DriverName& other) noexcept
+	{
+		m_long = std::move(other.m_long);
+		m_hash = other.m_hash;
+		m_length = other.m_length;
+		std::memcpy(m_text, other.m_text, sizeof(m_text));
+		std::memcpy(m_folded, other.m_folded, sizeof(m_folded));
+		other.reset();
+	}
+
+	void reset() noexcept
+	{
+		m_long.reset();
+		m_hash = static_cast<std::size_t>(FNV_OFFSET);
+		m_length = 0;
+		std::memset(m_text, 0, sizeof(m_text));
+		std::memset(m_folded, 0, sizeof(m_folded));
+	}
+
+	std::size_t					m_hash = static_cast<std::size_t>(FNV_OFFSET);		// Of the empty name
+	std::uint32_t				m_length = 0;
+	wchar_t						m_text[CAPACITY + 1] = {};				// Zero past m_length, so also a C string
+	wchar_t						m_folded[CAPACITY + 1] = {};
+	std::unique_ptr<wchar_t[]>	m_long;									// Only for names over CAPACITY
+
+};
+
+namespace std
+{
+	template <>
+	struct hash<DriverName>
+	{
+		std::size_t operator()(const DriverName& name) const noexcept { return name.hash(); }
+	};
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "DriverName.h"
+
+/*
+	File: DriverPatch.h
+
+	Description:
+		Node-level changes read from a patch CSV (Op,Type,Name,Range) and
+		applied to the loaded drivers by ImportEngine::apply_patch.
+
+		Changes are kept in file order, so adding and then removing the
+		same node in one patch leaves it removed.
+*/
+
+enum class PatchOp : std::uint8_t
+{
+	Add,				// "+" - add the node if the driver does not have it
+	Remove				// "-" - remove the node if the driver has it
+};
+
+struct NodeChange {
+
+	PatchOp						op;
+	std::uint32_t				node;					// IPv4 address, host order (192.168.1.10 = 0xC0A8010A)
+	std::uint32_t				line;					// Patch file line, for error messages
+
+};
+
+struct DriverPatch {
+
+	DriverName					name;					// The "Name" Registry value of the target driver
+	std::vector<NodeChange>		changes;				// In patch file order
+
+};
@@ -0,0 +1,466 @@
+#include "DriverSnapshot.h"
+#include "RegistryManager.h"
+#include "IPv4.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+// Private helper functions for DriverSnapshot
+namespace
+{
+	using namespace DriverSnapshot::Format;
+
+	constexpr std::uint64_t align8(std::uint64_t offset) noexcept
+	{
+		return (offset + 7) & ~std::uint64_t(7);
+	}
+
+	// Wide text appended to the text section as UTF-16
+	TextRef add_text(std::u16string& pool, std::wstring_view text)
+	{
+		const TextRef ref = { static_cast<std::uint32_t>(pool.size()), 0 };
+		for (const wchar_t c : text)
+		{
+			std::uint32_t cp = static_cast<std::uint32_t>(c);
+			if (cp > 0xFFFF)
+			{
+				cp -= 0x10000;
+				pool.push_back(static_cast<char16_t>(0xD800 + (cp >> 10)));
+				cp = 0xDC00 + (cp & 0x3FF);
+			}
+			pool.push_back(static_cast<char16_t>(cp));
+		}
+		return { ref.offset, static_cast<std::uint32_t>(pool.size() - ref.offset) };
+	}
+
+	// UTF-16 from the mapping back to wchar_t (joining surrogate pairs where wchar_t is UTF-32).
+	// out needs room for text.size() characters; returns how many were written.
+	std::size_t widen(std::u16string_view text, wchar_t* out) noexcept
+	{
+		std::size_t length = 0;
+		for (std::size_t i = 0; i < text.size(); ++i)
+		{
+			std::uint32_t unit = text[i];
+			if (sizeof(wchar_t) > 2 && unit >= 0xD800 && unit <= 0xDBFF && i + 1 < text.size() &&
+				text[i + 1] >= 0xDC00 && text[i + 1] <= 0xDFFF)
+			{
+				unit = 0x10000 + ((unit - 0xD800) << 10) + (text[i + 1] - 0xDC00);
+				++i;
+			}
+			out[length++] = static_cast<wchar_t>(unit);
+		}
+		return length;
+	}
+
+	void widen(std::u16string_view text, std::wstring& out)
+	{
+		out.resize(text.size());
+		out.resize(widen(text, &out[0]));
+	}
+
+	void widen(std::u16string_view text, DriverName& out)
+	{
+		if (text.size() <= DriverName::CAPACITY)
+		{
+			wchar_t buffer[DriverName::CAPACITY];
+			out.assign(std::wstring_view(buffer, widen(text, buffer)));
+			return;
+		}
+
+		// A name over the RSLinx limit (see DriverName)
+		std::wstring name;
+		widen(text, name);
+		out.assign(name);
+	}
+
+	bool section_fits(std::uint64_t offset, std::uint64_t count, std::uint64_t item_size, std::uint64_t file_size)
+	{
+		if (offset % 8 != 0 || offset > file_size)
+			return false;
+		return count <= (file_size - offset) / item_size;
+	}
+
+	bool text_fits(const TextRef& ref, std::uint64_t text_size)
+	{
+		return static_cast<std::uint64_t>(ref.offset) + ref.length <= text_size;
+	}
+}	// anonymous namespace
+
+
+namespace DriverSnapshot
+{
+	bool View::open(const std::wstring& path, std::wstring& error_message)
+	{
+		close();
+		error_message.clear();
+
+		if (m_file.Open(path) != ERROR_SUCCESS)
+		{
+			error_message = L"Failed to open file: " + path;
+			return false;
+		}
+
+		const std::uint64_t size = m_file.Size();
+		const char* data = m_file.Data();
+
+		const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+		if (size < sizeof(FileHeader) || header->magic != MAGIC)
+		{
+			close();
+			error_message = L"Not a QuickLinx snapshot file: " + path;
+			return false;
+		}
+
+		if (header->version != VERSION)
+		{
+			close();
+			error_message = L"Unsupported snapshot version " + std::to_wstring(header->version) + L": " + path;
+			return false;
+		}
+
+		// Check every section and record once, so the accessors can trust them
+		bool valid =
+			section_fits(header->drivers_offset, header->driver_count, sizeof(DriverRecord), size) &&
+			section_fits(header->nodes_offset, header->node_count, sizeof(std::uint32_t), size) &&
+			section_fits(header->text_nodes_offset, header->text_node_count, sizeof(TextRef), size) &&
+			section_fits(header->keys_offset, header->key_count, sizeof(TextRef), size) &&
+			section_fits(header->text_offset, header->text_size, sizeof(char16_t), size);
+
+		if (valid)
+		{
+			const DriverRecord* drivers = reinterpret_cast<const DriverRecord*>(data + header->drivers_offset);
+			const std::uint32_t* nodes = reinterpret_cast<const std::uint32_t*>(data + header->nodes_offset);
+			const TextRef* text_nodes = reinterpret_cast<const TextRef*>(data + header->text_nodes_offset);
+			const TextRef* keys = reinterpret_cast<const TextRef*>(data + header->keys_offset);
+
+			for (std::uint32_t i = 0; valid && i < header->driver_count; ++i)
+			{
+				const DriverRecord& driver = drivers[i];
+				valid = text_fits(driver.key_name, header->text_size) &&
+						text_fits(driver.name, header->text_size) &&
+						static_cast<std::uint64_t>(driver.first_node) + driver.node_count <= header->node_count;
+
+				if (valid && (driver.flags & DRIVER_TEXT_NODES) == 0)
+				{
+					valid = driver.node_count <= NodeList::CAPACITY;
+				}
+				else if (valid)
+				{
+					for (std::uint32_t n = 0; valid && n < driver.node_count; ++n)
+						valid = nodes[driver.first_node + n] < header->text_node_count;
+				}
+			}
+
+			for (std::uint32_t i = 0; valid && i < header->text_node_count; ++i)
+				valid = text_fits(text_nodes[i], header->text_size);
+
+			for (std::uint32_t i = 0; valid && i < header->key_count; ++i)
+				valid = text_fits(keys[i], header->text_size);
+		}
+
+		if (!valid)
+		{
+			close();
+			error_message = L"Snapshot file is damaged: " + path;
+			return false;
+		}
+
+		m_header = header;
+		m_drivers = reinterpret_cast<const DriverRecord*>(data + header->drivers_offset);
+		m_nodes = reinterpret_cast<const std::uint32_t*>(data + header->nodes_offset);
+		m_text_nodes = reinterpret_cast<const TextRef*>(data + header->text_nodes_offset);
+		m_keys = reinterpret_cast<const TextRef*>(data + header->keys_offset);
+		m_text = reinterpret_cast<const char16_t*>(data + header->text_offset);
+		return true;
+	}
+
+	void View::close() noexcept
+	{
+		m_file.Close();
+		m_header = nullptr;
+		m_drivers = nullptr;
+		m_nodes = nullptr;
+		m_text_nodes = nullptr;
+		m_keys = nullptr;
+		m_text = nullptr;
+	}
+
+	void View::to_driver(std::size_t driver, EthDriver& out) const
+	{
+		const DriverRecord& record = m_drivers[driver];
+
+		widen(text(record.key_name), out.key_name);
+		widen(text(record.name), out.name);
+		out.station = record.station;
+		out.ping_timeout = record.ping_timeout;
+		out.inactivity_timeout = record.inactivity_timeout;
+		out.startup = record.startup;
+
+		const std::uint32_t* entries = nodes(driver);
+		out.extra_nodes.clear();
+		if ((record.flags & DRIVER_TEXT_NODES) == 0)
+		{
+			// Checked by open() to fit
+			out.nodes.assign(entries, entries + record.node_count);
+			return;
+		}
+
+		// Text entries: sort them back into addresses and the rest, as a registry read would
+		out.nodes.clear();
+		std::wstring node;
+		for (std::uint32_t n = 0; n < record.node_count; ++n)
+		{
+			widen(text_node(entries[n]), node);
+
+			std::uint32_t address = 0;
+			if (IPv4::parse_address(std::wstring_view(node), address) != IPv4::ParseError::None ||
+				!out.nodes.push_back(address))
+			{
+				out.extra_nodes.push_back({ static_cast<std::uint32_t>(out.nodes.size()), node });
+			}
+		}
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: write_snapshot
+
+		Desc: Lays the drivers out in the snapshot format and writes the
+			  file in one go (to a temp file that then replaces path).
+			  The format is little-endian, which every Windows target is.
+		-----------------------------------------------------------------
+	*/
+	bool write_snapshot(			const std::wstring& path,
+									const std::vector<EthDriver>& drivers,
+									std::wstring& error_message,
+									const std::vector<std::wstring>& key_names)
+	{
+		error_message.clear();
+
+		std::vector<DriverRecord> records;
+		std::vector<std::uint32_t> nodes;
+		std::vector<TextRef> text_nodes;
+		std::u16string text;
+		records.reserve(drivers.size());
+
+		for (const EthDriver& driver : drivers)
+		{
+			DriverRecord record = {};
+			record.key_name = add_text(text, driver.key_name);
+			record.name = add_text(text, driver.name);
+			record.station = driver.station;
+			record.ping_timeout = driver.ping_timeout;
+			record.inactivity_timeout = driver.inactivity_timeout;
+			record.startup = driver.startup;
+			record.first_node = static_cast<std::uint32_t>(nodes.size());
+			record.node_count = static_cast<std::uint32_t>(driver.nodes.size() + driver.extra_nodes.size());
+
+			if (driver.extra_nodes.empty())
+			{
+				nodes.insert(nodes.end(), driver.nodes.begin(), driver.nodes.end());
+			}
+			else
+			{
+				// Every entry as text, in the order SaveDriver numbers them
+				record.flags |= DRIVER_TEXT_NODES;
+				auto add_node = [&](std::wstring_view node)
+					{
+						nodes.push_back(static_cast<std::uint32_t>(text_nodes.size()));
+						text_nodes.push_back(add_text(text, node));
+					};
+				for_each_node(driver,
+					[&](std::uint32_t address) { add_node(IPv4::to_wstring(address)); },
+					add_node);
+			}
+
+			records.push_back(record);
+		}
+
+		// Every key present at backup: the ones given, then any driver key they lack
+		std::vector<TextRef> keys;
+		std::unordered_set<std::wstring> listed;
+		auto add_key = [&](std::wstring_view key_name)
+			{
+				if (listed.insert(std::wstring(key_name)).second)
+					keys.push_back(add_text(text, key_name));
+			};
+		for (const std::wstring& key_name : key_names)
+			add_key(key_name);
+		for (const EthDriver& driver : drivers)
+			add_key(driver.key_name);
+
+		constexpr std::uint64_t LIMIT = std::numeric_limits<std::uint32_t>::max();
+		if (records.size() > LIMIT || nodes.size() > LIMIT || text_nodes.size() > LIMIT || keys.size() > LIMIT || text.size() > LIMIT)
+		{
+			error_message = L"Too many drivers for one snapshot file: " + path;
+			return false;
+		}
+
+		FileHeader header = {};
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.driver_count = static_cast<std::uint32_t>(records.size());
+		header.text_node_count = static_cast<std::uint32_t>(text_nodes.size());
+		header.key_count = static_cast<std::uint32_t>(keys.size());
+		header.node_count = nodes.size();
+		header.drivers_offset = align8(sizeof(FileHeader));
+		header.nodes_offset = align8(header.drivers_offset + records.size() * sizeof(DriverRecord));
+		header.text_nodes_offset = align8(header.nodes_offset + nodes.size() * sizeof(std::uint32_t));
+		header.keys_offset = align8(header.text_nodes_offset + text_nodes.size() * sizeof(TextRef));
+		header.text_offset = align8(header.keys_offset + keys.size() * sizeof(TextRef));
+		header.text_size = text.size();
+
+		// Assemble the whole file, then write it once
+		std::string image(static_cast<std::size_t>(header.text_offset + text.size() * sizeof(char16_t)), '\0');
+		auto put = [&image](std::uint64_t offset, const void* bytes, std::size_t size)
+			{
+				if (size != 0)
+					std::memcpy(&image[static_cast<std::size_t>(offset)], bytes, size);
+			};
+		put(0, &header, sizeof(header));
+		put(header.drivers_offset, records.data(), records.size() * sizeof(DriverRecord));
+		put(header.nodes_offset, nodes.data(), nodes.size() * sizeof(std::uint32_t));
+		put(header.text_nodes_offset, text_nodes.data(), text_nodes.size() * sizeof(TextRef));
+		put(header.keys_offset, keys.data(), keys.size() * sizeof(TextRef));
+		put(header.text_offset, text.data(), text.size() * sizeof(char16_t));
+
+		fs::path temp(path);
+		temp += L".tmp";
+		{
+			std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+			if (!file.is_open())
+			{
+				error_message = L"Failed to open file for writing: " + path;
+				return false;
+			}
+
+			file.write(image.data(), static_cast<std::streamsize>(image.size()));
+			file.close();
+			if (!file)
+			{
+				std::error_code ec;
+				fs::remove(temp, ec);
+				error_message = L"Error occurred while writing to file: " + path;
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		fs::rename(temp, fs::path(path), ec);
+		if (ec)
+		{
+			fs::remove(temp, ec);
+			error_message = L"Failed to replace file: " + path;
+			return false;
+		}
+		return true;
+	}
+
+	bool backup(					const std::wstring& path,
+									std::wstring& error_message)
+	{
+		// Listed before the drivers are read, so keys LoadDrivers skips
+		// (unreadable or incomplete) are still recorded
+		std::vector<std::wstring> key_names;
+		RegistryManager::EnumerateDriverKeys([&key_names](const std::wstring& key_name, ULONGLONG)
+			{
+				key_names.push_back(key_name);
+				return true;
+			});
+
+		return write_snapshot(path, RegistryManager::LoadDrivers(), error_message, key_names);
+	}
+
+	std::vector<std::wstring> keys_to_delete(	const View& view,
+												const std::vector<std::wstring>& existing)
+	{
+		std::unordered_set<std::wstring> captured;
+		captured.reserve(view.key_count() + view.driver_count());
+
+		std::wstring key_name;
+		for (std::size_t i = 0; i < view.key_count(); ++i)
+		{
+			widen(view.key(i), key_name);
+			captured.insert(key_name);
+		}
+		for (std::size_t i = 0; i < view.driver_count(); ++i)
+		{
+			widen(view.key_name(i), key_name);
+			captured.insert(key_name);
+		}
+
+		std::vector<std::wstring> stale;
+		for (const std::wstring& key : existing)
+		{
+			if (captured.count(key) == 0)
+				stale.push_back(key);
+		}
+		return stale;
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: restore
+
+		Desc: Saves every driver in the snapshot, then deletes the
+			  AB_ETH keys created since the backup. Keys the backup saw
+			  but could not read are left as they are. Drivers are copied
+			  out of the mapping one at a time into a single reused
+			  EthDriver.
+		-----------------------------------------------------------------
+	*/
+	RestoreResult restore(			const std::wstring& path)
+	{
+		RestoreResult result;
+
+		View view;
+		if (!view.open(path, result.error))
+		{
+			result.success = false;
+			return result;
+		}
+
+		// Keys present before the restore
+		std::vector<std::wstring> existing;
+		RegistryManager::EnumerateDriverKeys([&existing](const std::wstring& key_name, ULONGLONG)
+			{
+				existing.push_back(key_name);
+				return true;
+			});
+
+		EthDriver driver;
+		for (std::size_t i = 0; i < view.driver_count(); ++i)
+		{
+			view.to_driver(i, driver);
+
+			if (RegistryManager::SaveDriver(driver))
+			{
+				++result.saved;
+			}
+			else
+			{
+				result.success = false;
+				result.error += L"Failed to restore driver '" + driver.name.str() + L"' (" + driver.key_name.str() + L")\n";
+			}
+		}
+
+		for (const std::wstring& key_name : keys_to_delete(view, existing))
+		{
+			if (RegistryManager::DeleteDriver(key_name))
+			{
+				++result.deleted;
+			}
+			else
+			{
+				result.success = false;
+				result.error += L"Failed to delete driver " + key_name + L"\n";
+			}
+		}
+
+		return result;
+	}
+
+} // namespace DriverSnapshot
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "EthDriver.h"
+#include "MappedFile.h"
+
+/*
+	File: DriverSnapshot.h
+
+	Description:
+		Versioned binary snapshot of the whole AB_ETH driver set, for
+		backing up the registry before a change and restoring it quickly
+		afterwards.
+
+		The file is laid out so it can be used straight from a memory
+		mapping, with nothing decoded up front:
+
+			FileHeader
+			DriverRecord[driver_count]		fixed-size, one per driver
+			uint32[node_count]				packed node arrays
+			TextRef[text_node_count]		nodes that are not plain addresses
+			TextRef[key_count]				every AB_ETH key present at backup
+			char16_t[text_size]				key names, names and text nodes
+
+		Every section starts on an 8-byte boundary and all values are
+		little-endian. A driver's nodes are normally its packed NodeList
+		copied as is; a driver that also has text entries (host names,
+		see EthDriver::extra_nodes) is flagged, and its node entries then
+		index the TextRef table instead.
+
+		Restoring writes every driver in the snapshot with SaveDriver and
+		deletes AB_ETH keys created since the backup, so the time is
+		spent in registry writes rather than in reading the backup.
+
+		A backup also lists every AB_ETH key it saw, including keys it
+		could not read as a driver (unreadable, missing Name or Station).
+		Those keys are not in the driver records, and restore leaves them
+		alone rather than deleting what was never backed up.
+*/
+
+namespace DriverSnapshot
+{
+	namespace Format
+	{
+		constexpr std::uint32_t MAGIC = 0x42584C51;				// "QLXB"
+		constexpr std::uint32_t VERSION = 2;					// 2: key list
+
+		constexpr std::uint32_t DRIVER_TEXT_NODES = 0x1;		// DriverRecord::flags
+
+		// Slice of the text section, in UTF-16 code units
+		struct TextRef
+		{
+			std::uint32_t	offset;
+			std::uint32_t	length;
+		};
+
+		struct FileHeader
+		{
+			std::uint32_t	magic;
+			std::uint32_t	version;
+			std::uint32_t	driver_count;
+			std::uint32_t	text_node_count;
+			std::uint64_t	node_count;
+			std::uint64_t	drivers_offset;		// Byte offsets from the start of the file
+			std::uint64_t	nodes_offset;
+			std::uint64_t	text_nodes_offset;
+			std::uint64_t	text_offset;
+			std::uint64_t	text_size;			// In UTF-16 code units
+			std::uint32_t	key_count;
+			std::uint32_t	reserved;
+			std::uint64_t	keys_offset;
+		};
+
+		struct DriverRecord
+		{
+			TextRef			key_name;
+			TextRef			name;
+			std::uint32_t	station;
+			std::uint32_t	ping_timeout;
+			std::uint32_t	inactivity_timeout;
+			std::uint32_t	startup;
+			std::uint32_t	first_node;			// Index into the node array
+			std::uint32_t	node_count;
+			std::uint32_t	flags;
+			std::uint32_t	reserved;
+		};
+
+		static_assert(sizeof(FileHeader) == 80, "FileHeader layout is part of the file format");
+		static_assert(sizeof(DriverRecord) == 48, "DriverRecord layout is part of the file format");
+	}
+
+	//A snapshot file opened read-only by memory mapping. Accessors point
+	//straight into the mapping and stay valid until close().
+	class View
+	{
+	public:
+		// Map path and check that every record lies inside the file
+		bool open(const std::wstring& path, std::wstring& error_message);
+		void close() noexcept;
+
+		bool is_open() const noexcept { return m_header != nullptr; }
+
+		std::size_t driver_count() const noexcept { return m_header ? m_header->driver_count : 0; }
+		const Format::DriverRecord& record(std::size_t driver) const noexcept { return m_drivers[driver]; }
+
+		std::u16string_view key_name(std::size_t driver) const noexcept { return text(m_drivers[driver].key_name); }
+		std::u16string_view name(std::size_t driver) const noexcept { return text(m_drivers[driver].name); }
+
+		// The driver's node entries: addresses, or TextRef indices when
+		// record(driver).flags has DRIVER_TEXT_NODES
+		const std::uint32_t* nodes(std::size_t driver) const noexcept { return m_nodes + m_drivers[driver].first_node; }
+		std::u16string_view text_node(std::uint32_t index) const noexcept { return text(m_text_nodes[index]); }
+
+		// AB_ETH keys present when the snapshot was taken, read or not
+		std::size_t key_count() const noexcept { return m_header ? m_header->key_count : 0; }
+		std::u16string_view key(std::size_t index) const noexcept { return text(m_keys[index]); }
+
+		// Copy one driver out
+		void to_driver(std::size_t driver, EthDriver& out) const;
+
+	private:
+		std::u16string_view text(const Format::TextRef& ref) const noexcept
+		{
+			return std::u16string_view(m_text + ref.offset, ref.length);
+		}
+
+		MappedFile						m_file;
+		const Format::FileHeader*		m_header = nullptr;
+		const Format::DriverRecord*		m_drivers = nullptr;
+		const std::uint32_t*			m_nodes = nullptr;
+		const Format::TextRef*			m_text_nodes = nullptr;
+		const Format::TextRef*			m_keys = nullptr;
+		const char16_t*					m_text = nullptr;
+	};
+
+	//Write drivers (e.g. RegistryManager::LoadDrivers output) to a snapshot file.
+	//key_names lists every AB_ETH key present when they were read, including
+	//keys that could not be read; the drivers' own keys are always included.
+	bool write_snapshot(			const std::wstring& path,
+									const std::vector<EthDriver>& drivers,
+									std::wstring& error_message,
+									const std::vector<std::wstring>& key_names = {});
+
+	//Snapshot every AB_ETH driver in the registry
+	bool backup(					const std::wstring& path,
+									std::wstring& error_message);
+
+	struct RestoreResult
+	{
+		std::size_t					saved = 0;				// Drivers written from the snapshot
+		std::size_t					deleted = 0;			// Keys removed because they were created after the backup
+
+		std::wstring				error;					// Set when success is false
+
+		bool						success = true;			// Success flag
+	};
+
+	//Of the keys in existing, those restore deletes: keys that are neither a
+	//driver in the snapshot nor among the keys present at backup
+	std::vector<std::wstring> keys_to_delete(	const View& view,
+												const std::vector<std::wstring>& existing);
+
+	//Make the registry's AB_ETH drivers match the snapshot
+	RestoreResult restore(			const std::wstring& path);
+
+} // namespace DriverSnapshot
@@ -0,0 +1,129 @@
+#include "DriverTable.h"
+
+#include <algorithm>
+
+DriverTable::DriverTable(std::pmr::memory_resource* memory)
+	: m_key_names(memory)
+	, m_names(memory)
+	, m_stations(memory)
+	, m_ping_timeouts(memory)
+	, m_inactivity_timeouts(memory)
+	, m_startups(memory)
+	, m_nodes(memory)
+	, m_node_offsets(1, 0, memory)
+	, m_extra_nodes(memory)
+	, m_extra_before(memory)
+	, m_extra_offsets(1, 0, memory)
+{}
+
+DriverTable::DriverTable(const std::vector<EthDriver>& drivers, std::pmr::memory_resource* memory)
+	: DriverTable(memory)
+{
+	std::size_t nodes = 0;
+	for (const EthDriver& driver : drivers)
+		nodes += driver.nodes.size();
+
+	reserve(drivers.size(), nodes);
+	for (const EthDriver& driver : drivers)
+		append(driver);
+}
+
+void DriverTable::reserve(std::size_t drivers, std::size_t nodes)
+{
+	m_key_names.reserve(drivers);
+	m_names.reserve(drivers);
+	m_stations.reserve(drivers);
+	m_ping_timeouts.reserve(drivers);
+	m_inactivity_timeouts.reserve(drivers);
+	m_startups.reserve(drivers);
+
+	m_nodes.reserve(nodes);
+	m_node_offsets.reserve(drivers + 1);
+	m_extra_offsets.reserve(drivers + 1);
+}
+
+void DriverTable::append(const EthDriver& driver)
+{
+	m_key_names.push_back(driver.key_name);
+	m_names.push_back(driver.name);
+	m_stations.push_back(driver.station);
+	m_ping_timeouts.push_back(driver.ping_timeout);
+	m_inactivity_timeouts.push_back(driver.inactivity_timeout);
+	m_startups.push_back(driver.startup);
+
+	m_nodes.insert(m_nodes.end(), driver.nodes.begin(), driver.nodes.end());
+	m_node_offsets.push_back(static_cast<std::uint32_t>(m_nodes.size()));
+
+	for (const TextNode& node : driver.extra_nodes)
+	{
+		m_extra_nodes.emplace_back(node.text.data(), node.text.size());
+		m_extra_before.push_back(node.addresses_before);
+	}
+	m_extra_offsets.push_back(static_cast<std::uint32_t>(m_extra_nodes.size()));
+}
+
+void DriverTable::clear() noexcept
+{
+	m_key_names.clear();
+	m_names.clear();
+	m_stations.clear();
+	m_ping_timeouts.clear();
+	m_inactivity_timeouts.clear();
+	m_startups.clear();
+
+	m_nodes.clear();
+	m_node_offsets.assign(1, 0);
+	m_extra_nodes.clear();
+	m_extra_before.clear();
+	m_extra_offsets.assign(1, 0);
+}
+
+std::size_t DriverTable::find(const DriverName& name) const noexcept
+{
+	const auto found = std::find(m_names.begin(), m_names.end(), name);
+	return found == m_names.end() ? npos : static_cast<std::size_t>(found - m_names.begin());
+}
+
+std::size_t DriverTable::find_node(std::uint32_t address) const noexcept
+{
+	const auto found = std::find(m_nodes.begin(), m_nodes.end(), address);
+	if (found == m_nodes.end())
+		return npos;
+
+	// The row whose run holds the match (rows without nodes share its offset, so take the last)
+	const std::uint32_t position = static_cast<std::uint32_t>(found - m_nodes.begin());
+	const auto row = std::upper_bound(m_node_offsets.begin(), m_node_offsets.end(), position);
+	return static_cast<std::size_t>(row - m_node_offsets.begin()) - 1;
+}
+
+void DriverTable::driver(std::size_t row, EthDriver& out) const
+{
+	out.key_name = m_key_names[row];
+	out.name = m_names[row];
+	out.station = m_stations[row];
+	out.ping_timeout = m_ping_timeouts[row];
+	out.inactivity_timeout = m_inactivity_timeouts[row];
+	out.startup = m_startups[row];
+
+	const Slice<std::uint32_t> row_nodes = nodes(row);
+	out.nodes.assign(row_nodes.begin(), row_nodes.end());
+
+	out.extra_nodes.clear();
+	for (std::uint32_t i = m_extra_offsets[row]; i < m_extra_offsets[row + 1]; ++i)
+		out.extra_nodes.push_back({ m_extra_before[i], std::wstring(m_extra_nodes[i].data(), m_extra_nodes[i].size()) });
+}
+
+EthDriver DriverTable::driver(std::size_t row) const
+{
+	EthDriver out;
+	driver(row, out);
+	return out;
+}
+
+std::vector<EthDriver> DriverTable::to_drivers() const
+{
+	std::vector<EthDriver> drivers(size());
+	for (std::size_t row = 0; row < drivers.size(); ++row)
+		driver(row, drivers[row]);
+	return drivers;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+#include "EthDriver.h"
+
+/*
+	File: DriverTable.h
+
+	Description:
+		A whole driver set stored by column instead of as a vector of
+		EthDriver: one array per field, and every driver's nodes back to
+		back in a single pool with per-driver offsets.
+
+		Bulk work (finding a name or an address across thousands of
+		drivers, ImportEngine's matching) then streams through the one
+		column it needs instead of striding over ~1 KB per driver.
+
+		Build one from a vector (or append() drivers one at a time) and
+		turn rows back into EthDriver with driver() or to_drivers().
+		Rows are only ever appended.
+
+		The columns are allocated from the memory_resource given at
+		construction, so a table built for one operation can live in
+		that operation's arena (see ScratchArena.h).
+*/
+
+class DriverTable {
+
+public:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	// A driver's run within one of the pools
+	template <typename T>
+	struct Slice
+	{
+		const T*		first = nullptr;
+		const T*		last = nullptr;
+
+		const T* begin() const noexcept { return first; }
+		const T* end() const noexcept { return last; }
+		std::size_t size() const noexcept { return static_cast<std::size_t>(last - first); }
+		bool empty() const noexcept { return first == last; }
+		const T& operator[](std::size_t index) const noexcept { return first[index]; }
+	};
+
+	explicit DriverTable(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+	explicit DriverTable(const std::vector<EthDriver>& drivers,
+						 std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+	void reserve(std::size_t drivers, std::size_t nodes);
+	void append(const EthDriver& driver);
+	void clear() noexcept;
+
+	std::size_t size() const noexcept { return m_names.size(); }
+	bool empty() const noexcept { return m_names.empty(); }
+
+	// Columns, indexed by row
+	const std::pmr::vector<DriverName>& key_names() const noexcept { return m_key_names; }
+	const std::pmr::vector<DriverName>& names() const noexcept { return m_names; }
+	const std::pmr::vector<DWORD>& stations() const noexcept { return m_stations; }
+
+	const DriverName& key_name(std::size_t row) const noexcept { return m_key_names[row]; }
+	const DriverName& name(std::size_t row) const noexcept { return m_names[row]; }
+	DWORD station(std::size_t row) const noexcept { return m_stations[row]; }
+	DWORD ping_timeout(std::size_t row) const noexcept { return m_ping_timeouts[row]; }
+	DWORD inactivity_timeout(std::size_t row) const noexcept { return m_inactivity_timeouts[row]; }
+	DWORD startup(std::size_t row) const noexcept { return m_startups[row]; }
+
+	Slice<std::uint32_t> nodes(std::size_t row) const noexcept
+	{
+		return { m_nodes.data() + m_node_offsets[row], m_nodes.data() + m_node_offsets[row + 1] };
+	}
+
+	Slice<std::pmr::wstring> extra_nodes(std::size_t row) const noexcept
+	{
+		return { m_extra_nodes.data() + m_extra_offsets[row], m_extra_nodes.data() + m_extra_offsets[row + 1] };
+	}
+
+	// Node Table entries the driver uses (addresses plus text entries)
+	std::size_t node_count(std::size_t row) const noexcept { return nodes(row).size() + extra_nodes(row).size(); }
+
+	// First row with this name, or npos
+	std::size_t find(const DriverName& name) const noexcept;
+
+	// First row whose Node Table has this address, or npos
+	std::size_t find_node(std::uint32_t address) const noexcept;
+
+	// Copy rows back out
+	void driver(std::size_t row, EthDriver& out) const;
+	EthDriver driver(std::size_t row) const;
+	std::vector<EthDriver> to_drivers() const;
+
+private:
+	std::pmr::vector<DriverName>		m_key_names;
+	std::pmr::vector<DriverName>		m_names;
+	std::pmr::vector<DWORD>				m_stations;
+	std::pmr::vector<DWORD>				m_ping_timeouts;
+	std::pmr::vector<DWORD>				m_inactivity_timeouts;
+	std::pmr::vector<DWORD>				m_startups;
+
+	std::pmr::vector<std::uint32_t>		m_nodes;					// Every driver's addresses, in row order
+	std::pmr::vector<std::uint32_t>		m_node_offsets;				// Row i owns [offsets[i], offsets[i + 1])
+
+	std::pmr::vector<std::pmr::wstring>	m_extra_nodes;				// Text entries, same layout (text from the same resource)
+	std::pmr::vector<std::uint32_t>		m_extra_before;				// Their TextNode::addresses_before
+	std::pmr::vector<std::uint32_t>		m_extra_offsets;
+
+};
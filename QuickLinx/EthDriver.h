@@ -3,7 +3,15 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+
+#include "DriverName.h"
+#include "NodeList.h"
+
+#ifdef _WIN32
 #include <windows.h>
+#else
+using DWORD = std::uint32_t;		// Offline tools (e.g. .reg snapshot analysis) build without windows.h
+#endif
 
 /*
 	File: EthDriver.h
@@ -14,15 +22,47 @@
 		HKLM\\SOFTWARE\\WOW6432Node\\Rockwell Software\\RSLinx\\Drivers\\AB_ETH\\AB_ETH-x
 */
 
+// A Node Table entry that is not an IPv4 address (e.g. a host name), kept as text
+struct TextNode {
+
+	std::uint32_t				addresses_before;		// How many of the driver's addresses precede it in the Node Table
+	std::wstring				text;
+
+	bool operator==(const TextNode& other) const { return addresses_before == other.addresses_before && text == other.text; }
+	bool operator!=(const TextNode& other) const { return !(*this == other); }
+
+};
+
 struct EthDriver {
 
-	std::wstring				key_name;				// "AB_ETH-1", "AB_ETH-2", ...
-	std::wstring				name;					// The "Name" Registry value
+	DriverName					key_name;				// "AB_ETH-1", "AB_ETH-2", ...
+	DriverName					name;					// The "Name" Registry value (RSLinx allows 15 characters)
 	DWORD						station;				// The "Station" DWORD
 	DWORD						ping_timeout;			// The "Ping Timeout" DWORD (seconds)
 	DWORD						inactivity_timeout;		// The "Inactivity Timeout" DWORD (seconds)
 	DWORD						startup;				// The "Startup" DWORD (0 or 1)
 	
-	std::vector<std::wstring>	nodes;					// Each entry under the Node Table
+	NodeList					nodes;					// Node Table addresses, packed (see NodeList.h)
+	std::vector<TextNode>		extra_nodes;			// Node Table entries that are not IPv4 addresses, in table order
+
+};
+
+// Visits a driver's Node Table entries in table order: on_address(std::uint32_t)
+// for each address and on_text(const std::wstring&) for each text entry, so a
+// table read and saved again keeps every entry in its slot
+template <typename OnAddress, typename OnText>
+void for_each_node(const EthDriver& driver, OnAddress&& on_address, OnText&& on_text)
+{
+	std::size_t text = 0;
+	for (std::size_t address = 0; address <= driver.nodes.size(); ++address)
+	{
+		while (text < driver.extra_nodes.size() &&
+			   (driver.extra_nodes[text].addresses_before <= address || address == driver.nodes.size()))
+		{
+			on_text(driver.extra_nodes[text++].text);
+		}
 
-};
\ No newline at end of file
+		if (address < driver.nodes.size())
+			on_address(driver.nodes[address]);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+/*
+	File: IPv4.h
+
+	Description:
+		Exception-free, allocation-free parsing of IPv4 addresses, last-octet
+		ranges ("a.b.c.x-y"), CIDR subnets ("a.b.c.d/n") and plain unsigned
+		numbers.
+
+		Every parser works on std::basic_string_view of char or wchar_t, is
+		constexpr, and returns a ParseError code instead of throwing.
+		Addresses are packed into a std::uint32_t, most significant octet first.
+
+		Shared by the CSV reader/writer and ImportEngine.
+*/
+
+namespace IPv4
+{
+	enum class ParseError
+	{
+		None,
+		Empty,				// nothing to parse
+		BadDigit,			// a character other than 0-9 where a number was expected
+		Overflow,			// number larger than allowed (255 for an octet)
+		OctetCount,			// not exactly four dot-separated octets
+		BadRange,			// malformed or reversed "x-y" in a range
+		BadPrefix			// missing or out-of-range "/n" in a subnet
+	};
+
+	// An inclusive run of addresses within one /24
+	struct Range
+	{
+		std::uint32_t	first = 0;
+		std::uint32_t	last = 0;
+	};
+
+	// A CIDR block, e.g. 10.20.0.0/16
+	struct Subnet
+	{
+		std::uint32_t	network = 0;		// host bits cleared
+		std::uint32_t	mask = 0;
+
+		constexpr bool contains(std::uint32_t address) const noexcept
+		{
+			return (address & mask) == network;
+		}
+	};
+
+	namespace detail
+	{
+		template <typename CharT>
+		constexpr bool is_space(CharT ch) noexcept
+		{
+			return ch == CharT(' ') || (ch >= CharT('\t') && ch <= CharT('\r'));
+		}
+
+		template <typename CharT>
+		constexpr std::basic_string_view<CharT> trim(std::basic_string_view<CharT> s) noexcept
+		{
+			while (!s.empty() && is_space(s.front()))
+				s.remove_prefix(1);
+			while (!s.empty() && is_space(s.back()))
+				s.remove_suffix(1);
+			return s;
+		}
+	}
+
+	// Parse a run of decimal digits no larger than max. No sign, no whitespace.
+	// Leading zeros are accepted and still read as decimal ("010" is 10, not
+	// octal 8), as the std::stoi checks this replaced did.
+	template <typename CharT>
+	constexpr ParseError parse_uint(	std::basic_string_view<CharT> s,
+										std::uint32_t max,
+										std::uint32_t& value_out) noexcept
+	{
+		if (s.empty())
+			return ParseError::Empty;
+
+		std::uint64_t value = 0;
+		for (CharT ch : s)
+		{
+			if (ch < CharT('0') || ch > CharT('9'))
+				return ParseError::BadDigit;
+
+			value = value * 10 + static_cast<std::uint64_t>(ch - CharT('0'));
+			if (value > max)
+				return ParseError::Overflow;
+		}
+
+		value_out = static_cast<std::uint32_t>(value);
+		return ParseError::None;
+	}
+
+	// Parse exactly 'count' dot-separated octets into the low bytes of value_out
+	template <typename CharT>
+	constexpr ParseError parse_octets(	std::basic_string_view<CharT> s,
+										std::size_t count,
+										std::uint32_t& value_out) noexcept
+	{
+		std::uint32_t value = 0;
+		std::size_t parts = 0;
+
+		while (true)
+		{
+			const std::size_t dot = s.find(CharT('.'));
+			const std::basic_string_view<CharT> part = s.substr(0, dot);
+
+			std::uint32_t octet = 0;
+			const ParseError error = parse_uint(part, 255, octet);
+			if (error != ParseError::None)
+				return (error == ParseError::Empty) ? ParseError::OctetCount : error;
+
+			if (++parts > count)
+				return ParseError::OctetCount;
+			value = (value << 8) | octet;
+
+			if (dot == std::basic_string_view<CharT>::npos)
+				break;
+			s.remove_prefix(dot + 1);
+		}
+
+		if (parts != count)
+			return ParseError::OctetCount;
+
+		value_out = value;
+		return ParseError::None;
+	}
+
+	// Parse "a.b.c.d". Surrounding whitespace is ignored.
+	template <typename CharT>
+	constexpr ParseError parse_address(	std::basic_string_view<CharT> s,
+										std::uint32_t& address_out) noexcept
+	{
+		s = detail::trim(s);
+		if (s.empty())
+			return ParseError::Empty;
+
+		return parse_octets(s, 4, address_out);
+	}
+
+	// True if s holds a '-' and should be parsed as a range
+	template <typename CharT>
+	constexpr bool is_range(std::basic_string_view<CharT> s) noexcept
+	{
+		return s.find(CharT('-')) != std::basic_string_view<CharT>::npos;
+	}
+
+	// Parse "a.b.c.x-y" (whitespace allowed around x and y).
+	// The "x-y" part is checked first and any problem there, including
+	// y < x, is reported as BadRange. Problems in "a.b.c" use the address codes.
+	template <typename CharT>
+	constexpr ParseError parse_range(	std::basic_string_view<CharT> s,
+										Range& range_out) noexcept
+	{
+		s = detail::trim(s);
+		if (s.empty())
+			return ParseError::Empty;
+
+		const std::size_t last_dot = s.rfind(CharT('.'));
+		if (last_dot == std::basic_string_view<CharT>::npos)
+			return ParseError::BadRange;
+
+		const std::basic_string_view<CharT> tail = s.substr(last_dot + 1);
+		const std::size_t dash = tail.find(CharT('-'));
+		if (dash == std::basic_string_view<CharT>::npos)
+			return ParseError::BadRange;
+
+		std::uint32_t first = 0;
+		std::uint32_t last = 0;
+		if (parse_uint(detail::trim(tail.substr(0, dash)), 255, first) != ParseError::None ||
+			parse_uint(detail::trim(tail.substr(dash + 1)), 255, last) != ParseError::None ||
+			last < first)
+		{
+			return ParseError::BadRange;
+		}
+
+		std::uint32_t subnet = 0;
+		const ParseError error = parse_octets(s.substr(0, last_dot), 3, subnet);
+		if (error != ParseError::None)
+			return error;
+
+		range_out.first = (subnet << 8) | first;
+		range_out.last = (subnet << 8) | last;
+		return ParseError::None;
+	}
+
+	// Parse "a.b.c.d/n" (n = 0..32). Host bits in the address are ignored.
+	template <typename CharT>
+	constexpr ParseError parse_subnet(	std::basic_string_view<CharT> s,
+										Subnet& subnet_out) noexcept
+	{
+		s = detail::trim(s);
+		if (s.empty())
+			return ParseError::Empty;
+
+		const std::size_t slash = s.find(CharT('/'));
+		if (slash == std::basic_string_view<CharT>::npos)
+			return ParseError::BadPrefix;
+
+		std::uint32_t prefix = 0;
+		if (parse_uint(detail::trim(s.substr(slash + 1)), 32, prefix) != ParseError::None)
+			return ParseError::BadPrefix;
+
+		std::uint32_t address = 0;
+		const ParseError error = parse_address(s.substr(0, slash), address);
+		if (error != ParseError::None)
+			return error;
+
+		subnet_out.mask = (prefix == 0) ? 0 : (~std::uint32_t(0) << (32 - prefix));
+		subnet_out.network = address & subnet_out.mask;
+		return ParseError::None;
+	}
+
+	// Write "a.b.c.d" into buf (at least 15 characters). Returns the length.
+	template <typename CharT>
+	constexpr std::size_t format(std::uint32_t address, CharT* buf) noexcept
+	{
+		std::size_t len = 0;
+		for (int shift = 24; shift >= 0; shift -= 8)
+		{
+			const std::uint32_t octet = (address >> shift) & 0xFF;
+			if (octet >= 100)
+				buf[len++] = static_cast<CharT>('0' + octet / 100);
+			if (octet >= 10)
+				buf[len++] = static_cast<CharT>('0' + (octet / 10) % 10);
+			buf[len++] = static_cast<CharT>('0' + octet % 10);
+
+			if (shift != 0)
+				buf[len++] = CharT('.');
+		}
+		return len;
+	}
+
+	// "a.b.c.d" as a wide string (for EthDriver nodes and messages)
+	inline std::wstring to_wstring(std::uint32_t address)
+	{
+		wchar_t buf[16] = {};
+		return std::wstring(buf, format(address, buf));
+	}
+}
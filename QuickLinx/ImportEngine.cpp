@@ -1,61 +1,97 @@
 #include "ImportEngine.h"
+#include "IPv4.h"
+#include "ScratchArena.h"
 
-#include <map>
-#include <set>
+#include <memory_resource>
+#include <unordered_map>
 #include <algorithm>
 #include <sstream>
 #include <cwctype>
+#include <climits>
 
 // Private helper functions for ImportEngine
 namespace 
 {
-	constexpr std::size_t MAX_NODES_PER_DRIVER = 254;		// 0..255 except 63 reserved
+	constexpr std::size_t MAX_NODES_PER_DRIVER = NodeList::CAPACITY;		// 0..255 except 63 reserved
+
+	// Driver key names are KEY_PREFIX followed by a decimal index
+	constexpr std::wstring_view KEY_PREFIX = L"AB_ETH-";
 
 	// Extracts the index from an AB_ETH-x key name.
-	int extract_index(const std::wstring& key_name)
+	int extract_index(const DriverName& key_name)
 	{
-		const std::wstring prefix = L"AB_ETH-";
-		
-		if (key_name.find(prefix, 0) != 0)
+		const std::wstring_view key = key_name.view();
+
+		if (key.substr(0, KEY_PREFIX.size()) != KEY_PREFIX)
 			return -1; // Not a valid AB_ETH entry
-		
-		try 
-		{
-			return std::stoi(key_name.substr(prefix.size()));
-		}
-		catch (...)
-		{
+
+		std::uint32_t index = 0;
+		if (IPv4::parse_uint(key.substr(KEY_PREFIX.size()), INT_MAX, index) != IPv4::ParseError::None)
 			return -1; // Conversion failed
-		}
+
+		return static_cast<int>(index);
 	}
 
 	// Finds the maximum index among AB_ETH-x entries in the registry drivers.
-	int find_max_index(const std::vector<EthDriver>& registry_drivers)
+	int find_max_index(const DriverTable& registry_drivers)
 	{
 		int max_index = 0;
-		for (const auto& d : registry_drivers)
+		for (const DriverName& key_name : registry_drivers.key_names())
 		{
-			int idx = extract_index(d.key_name);
+			int idx = extract_index(key_name);
 			if (idx > max_index)
 				max_index = idx;
 		}
 		return max_index;
 	}
 
-	// Prevent duplicate nodes by collecting all nodes into a std::set
-	std::set<std::wstring> collect_nodes(const std::vector<std::wstring>& driver_nodes)
+	// Builds the AB_ETH-x key name for index, without going through std::wstring
+	DriverName make_key_name(int index)
 	{
-		std::set<std::wstring> node_set;
-		for (const auto& d : driver_nodes) 
+		wchar_t buffer[32];
+		std::size_t length = KEY_PREFIX.copy(buffer, KEY_PREFIX.size());
+
+		wchar_t digits[10];
+		std::size_t count = 0;
+		unsigned value = static_cast<unsigned>(index);
+		do
 		{
-			node_set.insert(d);
+			digits[count++] = static_cast<wchar_t>(L'0' + value % 10);
+			value /= 10;
+		} while (value != 0);
+
+		while (count > 0)
+			buffer[length++] = digits[--count];
+
+		return DriverName(std::wstring_view(buffer, length));
+	}
+
+	// Node Table entries a driver uses (addresses plus text entries)
+	std::size_t node_count(const EthDriver& driver)
+	{
+		return driver.nodes.size() + driver.extra_nodes.size();
+	}
+
+	// Removes an address; text entries after it move up a slot with the addresses
+	bool remove_node(EthDriver& driver, std::uint32_t address)
+	{
+		const auto found = std::find(driver.nodes.begin(), driver.nodes.end(), address);
+		if (found == driver.nodes.end())
+			return false;
+
+		const std::uint32_t index = static_cast<std::uint32_t>(found - driver.nodes.begin());
+		driver.nodes.remove(address);
+		for (TextNode& node : driver.extra_nodes)
+		{
+			if (node.addresses_before > index)
+				--node.addresses_before;
 		}
-		return node_set;
+		return true;
 	}
 
 	//For creating new Ethernet Driver struct
-	EthDriver create_driver(	const std::wstring& key_name,
-								const std::wstring& display_name)
+	EthDriver create_driver(	const DriverName& key_name,
+								const DriverName& display_name)
 	{
 		EthDriver driver;
 		
@@ -78,49 +114,92 @@ namespace ImportEngine
 {
 	
 	ImportResult merge_drivers(		const std::vector<EthDriver>& registry_drivers,
-									const std::vector<EthDriver>& csv_drivers)
+									const std::vector<EthDriver>& csv_drivers,
+									std::pmr::memory_resource* memory)
+	{
+		ScratchArena scratch(memory);
+		return merge_drivers(	DriverTable(registry_drivers, scratch.resource()),
+								DriverTable(csv_drivers, scratch.resource()),
+								scratch.resource());
+	}
+
+	ImportResult overwrite_drivers(	const std::vector<EthDriver>& registry_drivers, 
+									const std::vector<EthDriver>& csv_drivers,
+									std::pmr::memory_resource* memory)
+	{
+		ScratchArena scratch(memory);
+		return overwrite_drivers(	DriverTable(registry_drivers, scratch.resource()),
+									DriverTable(csv_drivers, scratch.resource()),
+									scratch.resource());
+	}
+
+	ImportResult apply_patch(		const std::vector<EthDriver>& registry_drivers,
+									const std::vector<DriverPatch>& patches,
+									std::pmr::memory_resource* memory)
+	{
+		ScratchArena scratch(memory);
+		return apply_patch(DriverTable(registry_drivers, scratch.resource()), patches, scratch.resource());
+	}
+
+	ImportResult merge_drivers(		const DriverTable& registry_drivers,
+									const DriverTable& csv_drivers,
+									std::pmr::memory_resource* memory)
 	{
 		ImportResult result;
+		ScratchArena scratch(memory);
 
 		int max_AB_ETH_index = find_max_index(registry_drivers);
 
 		// No drivers in CSV to import
 		if (csv_drivers.empty() && !registry_drivers.empty())
 		{
-			result.errors.push_back(L"No drivers found in CSV import.");
+			result.errors.add(Diagnostics::Code::NoDriversToMerge);
 			result.success = false;
 			return result;
 		}
 
-		// Map existing registry drivers by key_name for quick lookup
-		std::map<std::wstring, EthDriver> registry_map;
+		// Map existing registry drivers by name for quick lookup (a repeated name maps to its last row)
+		std::pmr::unordered_map<DriverName, std::size_t> registry_rows(scratch.resource());
+		registry_rows.reserve(registry_drivers.size());
+		for (std::size_t row = 0; row < registry_drivers.size(); ++row)
+			registry_rows[registry_drivers.name(row)] = row;
 
-		for (const auto& reg_driver : registry_drivers)
-		{
-			registry_map[reg_driver.name] = reg_driver;
-		}
+		// Registry drivers merged so far, copied out of the table on first use
+		std::pmr::unordered_map<std::size_t, EthDriver> merged(scratch.resource());
+
+		// One driver's nodes, sorted and without duplicates; reused for every matched row
+		std::pmr::vector<std::uint32_t> node_set(scratch.resource());
+		node_set.reserve(MAX_NODES_PER_DRIVER);
 
 		// Process each CSV driver
-		for (const auto& csv_driver : csv_drivers)
+		for (std::size_t csv_row = 0; csv_row < csv_drivers.size(); ++csv_row)
 		{
-			auto found_driver = registry_map.find(csv_driver.name);	
-			if (found_driver != registry_map.end())
+			auto found_driver = registry_rows.find(csv_drivers.name(csv_row));
+			if (found_driver != registry_rows.end())
 			{
 				// Existing driver
-				EthDriver& reg_driver = found_driver->second;
-				// Merge nodes, avoiding duplicates
-				std::set<std::wstring> node_set = collect_nodes(reg_driver.nodes);
-				for (const auto& node : csv_driver.nodes)
+				auto [entry, first_use] = merged.try_emplace(found_driver->second);
+				EthDriver& reg_driver = entry->second;
+				if (first_use)
+					registry_drivers.driver(found_driver->second, reg_driver);
+
+				// Merge nodes, avoiding duplicates (text entries keep their slots)
+				node_set.assign(reg_driver.nodes.begin(), reg_driver.nodes.end());
+				std::sort(node_set.begin(), node_set.end());
+				node_set.erase(std::unique(node_set.begin(), node_set.end()), node_set.end());
+				for (const std::uint32_t node : csv_drivers.nodes(csv_row))
 				{
-					if (node_set.size() >= MAX_NODES_PER_DRIVER)
+					if (node_set.size() + reg_driver.extra_nodes.size() >= MAX_NODES_PER_DRIVER)
 					{
 						// Reached max nodes (CSV parser prevents adding more than 254 nodes. This condition is just a safeguard)
-						result.errors.push_back(
-							L"Driver '" + reg_driver.name + L"' (" + reg_driver.key_name +
-							L") has reached maximum node limit. Extra nodes were skipped.");
+						result.errors.add(Diagnostics::Code::MergeNodeLimit, 0, Diagnostics::COLUMN_NONE,
+							reg_driver.name, reg_driver.key_name);
 						break;
 					}
-					node_set.insert(node);
+
+					const auto position = std::lower_bound(node_set.begin(), node_set.end(), node);
+					if (position == node_set.end() || *position != node)
+						node_set.insert(position, node);
 				}
 				// Update the driver's nodes from the set
 				reg_driver.nodes.assign(node_set.begin(), node_set.end());
@@ -129,61 +208,141 @@ namespace ImportEngine
 			else
 			{
 				// New driver - assign new key_name if necessary
-				EthDriver new_driver = csv_driver;
+				EthDriver new_driver = csv_drivers.driver(csv_row);
 				if (extract_index(new_driver.key_name) == -1)
 				{
 					max_AB_ETH_index++;
-					new_driver.key_name = L"AB_ETH-" + std::to_wstring(max_AB_ETH_index);
+					new_driver.key_name = make_key_name(max_AB_ETH_index);
 				}
-				result.new_drivers.push_back(new_driver);
+				result.new_drivers.push_back(std::move(new_driver));
 			}
 		}
 
 		return result;
 	}
 
-	ImportResult overwrite_drivers(	const std::vector<EthDriver>& registry_drivers, 
-									const std::vector<EthDriver>& csv_drivers)
+	ImportResult overwrite_drivers(	const DriverTable& registry_drivers, 
+									const DriverTable& csv_drivers,
+									std::pmr::memory_resource* memory)
 	{
 		ImportResult result;
+		ScratchArena scratch(memory);
 
 		int max_AB_ETH_index = find_max_index(registry_drivers);
 
 		// No drivers in CSV to import - (safeguard though this should be handled before calling this function)
 		if (csv_drivers.empty() && !registry_drivers.empty())
 		{
-			result.errors.push_back(L"Overwrite failed. No drivers found in CSV import.");
+			result.errors.add(Diagnostics::Code::NoDriversToOverwrite);
 			result.success = false;
 			return result;
 		}
 
+		// Map existing registry drivers by name (a repeated name maps to its first row)
+		std::pmr::unordered_map<DriverName, std::size_t> registry_rows(scratch.resource());
+		registry_rows.reserve(registry_drivers.size());
+		for (std::size_t row = 0; row < registry_drivers.size(); ++row)
+			registry_rows.emplace(registry_drivers.name(row), row);
+
 		// Compare CSV drivers against registry drivers
 		// If match is found (by name), update registry driver nodes
 		// If no match, create new driver entry
-		for (const auto& csv_driver : csv_drivers)
+		for (std::size_t csv_row = 0; csv_row < csv_drivers.size(); ++csv_row)
 		{
-			auto found_driver = std::find_if(registry_drivers.begin(), registry_drivers.end(),
-				[&csv_driver](const EthDriver& reg_driver)
-				{
-					return reg_driver.name == csv_driver.name;
-				});
-			if (found_driver != registry_drivers.end())
+			auto found_driver = registry_rows.find(csv_drivers.name(csv_row));
+			if (found_driver != registry_rows.end())
 			{
 				// Existing driver found - overwrite nodes
-				EthDriver updated_driver = *found_driver;
-				updated_driver.nodes = csv_driver.nodes;
-				result.updated_drivers.push_back(updated_driver);
+				EthDriver updated_driver = registry_drivers.driver(found_driver->second);
+				const auto csv_nodes = csv_drivers.nodes(csv_row);
+				updated_driver.nodes.assign(csv_nodes.begin(), csv_nodes.end());
+				updated_driver.extra_nodes.clear();			// Host-name entries are replaced too
+				result.updated_drivers.push_back(std::move(updated_driver));
 			}
 			else
 			{
 				// New driver - assign new key_name if necessary
-				EthDriver new_driver = csv_driver;
+				EthDriver new_driver = csv_drivers.driver(csv_row);
 				if (extract_index(new_driver.key_name) == -1)
 				{
 					max_AB_ETH_index++;
-					new_driver.key_name = L"AB_ETH-" + std::to_wstring(max_AB_ETH_index);
+					new_driver.key_name = make_key_name(max_AB_ETH_index);
 				}
-				result.new_drivers.push_back(new_driver);
+				result.new_drivers.push_back(std::move(new_driver));
+			}
+		}
+
+		return result;
+	}
+
+	ImportResult apply_patch(		const DriverTable& registry_drivers,
+									const std::vector<DriverPatch>& patches,
+									std::pmr::memory_resource* memory)
+	{
+		ImportResult result;
+		ScratchArena scratch(memory);
+
+		int max_AB_ETH_index = find_max_index(registry_drivers);
+
+		// Map existing registry drivers by name for quick lookup
+		std::pmr::unordered_map<DriverName, std::size_t> registry_rows(scratch.resource());
+		registry_rows.reserve(registry_drivers.size());
+		for (std::size_t row = 0; row < registry_drivers.size(); ++row)
+			registry_rows.emplace(registry_drivers.name(row), row);
+
+		for (const auto& patch : patches)
+		{
+			auto found_driver = registry_rows.find(patch.name);
+			const bool is_new = (found_driver == registry_rows.end());
+
+			// A new driver takes the next key, but only claims it if it is kept
+			EthDriver driver = is_new
+				? create_driver(make_key_name(max_AB_ETH_index + 1), patch.name)
+				: registry_drivers.driver(found_driver->second);
+
+			// Apply changes in patch order
+			bool changed = false;
+			bool limit_reported = false;
+
+			for (const auto& change : patch.changes)
+			{
+				if (change.op == PatchOp::Add)
+				{
+					if (driver.nodes.contains(change.node))
+						continue;
+
+					if (node_count(driver) >= MAX_NODES_PER_DRIVER)
+					{
+						if (!limit_reported)
+						{
+							result.errors.add(Diagnostics::Code::MergeNodeLimit, change.line, Diagnostics::COLUMN_NONE,
+								driver.name, driver.key_name);
+							limit_reported = true;
+						}
+						continue;
+					}
+
+					driver.nodes.push_back(change.node);
+					changed = true;
+				}
+				else if (remove_node(driver, change.node))
+				{
+					changed = true;
+				}
+			}
+
+			if (!changed)
+				continue;
+
+			if (!is_new)
+			{
+				result.updated_drivers.push_back(std::move(driver));
+			}
+			else if (!driver.nodes.empty())
+			{
+				// New driver - only created if the patch leaves it with nodes
+				max_AB_ETH_index++;
+				result.new_drivers.push_back(std::move(driver));
 			}
 		}
 
@@ -2,20 +2,36 @@
 
 #include <vector>
 #include <string>
+#include <memory_resource>
 
 #include "EthDriver.h"
+#include "DriverTable.h"
+#include "Diagnostics.h"
+#include "DriverPatch.h"
 
 /*
 	File: ImportEngine.h
 
 	Description: 
 		Provides functions to merge_drivers or overwrite_drivers EthDriver entries
-		from a CSV import into the existing registry entries.
+		from a CSV import into the existing registry entries, or to
+		apply_patch node-level changes from a patch CSV.
 
 		Functions return an ImportResult struct containing
 		details about the operation, including updated drivers,
 		new drivers added, any errors encountered, and a success flag.
 
+		Each function also takes a DriverTable, which is what the work is
+		done on; the std::vector overloads copy their input into one
+		first, so callers that can build tables directly (the UI loads
+		the registry with RegistryManager::LoadDrivers(DriverTable&))
+		should pass those.
+
+		memory is where a call's temporary tables, indexes and node sets
+		go (see ScratchArena.h). With nullptr each call uses its own
+		arena and frees it as one block on return. ImportResult is
+		always allocated normally.
+
 		Helper functions are included in ImportEngine.cpp under a private namespace
 */
 
@@ -26,17 +42,38 @@ namespace ImportEngine
 		std::vector<EthDriver>		updated_drivers;		// Drivers that were modified	(Existing registry entries)
 		std::vector<EthDriver>		new_drivers;			// Drivers that were added		(New AB_ETH-x entries)		
 			
-		std::vector<std::wstring>	errors;					// Any errors that occurred during the import process
+		Diagnostics::List			errors;					// Any errors that occurred during the import process
 
 		bool						success = true;			// Success flag
 	};
 
 	// Merges the imported drivers into the registry drivers.
 	ImportResult merge_drivers(				const std::vector<EthDriver>& registry_drivers,
-									const std::vector<EthDriver>& csv_drivers);
+									const std::vector<EthDriver>& csv_drivers,
+									std::pmr::memory_resource* memory = nullptr);
 
 	// Overwrites the registry drivers with the imported drivers.
 	ImportResult overwrite_drivers(			const std::vector<EthDriver>& registry_drivers,
-									const std::vector<EthDriver>& csv_drivers);
+									const std::vector<EthDriver>& csv_drivers,
+									std::pmr::memory_resource* memory = nullptr);
+
+	// Applies node additions/removals to the registry drivers. Only drivers
+	// the patch touches are looked at, and only those it changes are returned.
+	ImportResult apply_patch(				const std::vector<EthDriver>& registry_drivers,
+									const std::vector<DriverPatch>& patches,
+									std::pmr::memory_resource* memory = nullptr);
+
+	// The same operations on columnar driver sets
+	ImportResult merge_drivers(				const DriverTable& registry_drivers,
+									const DriverTable& csv_drivers,
+									std::pmr::memory_resource* memory = nullptr);
+
+	ImportResult overwrite_drivers(			const DriverTable& registry_drivers,
+									const DriverTable& csv_drivers,
+									std::pmr::memory_resource* memory = nullptr);
+
+	ImportResult apply_patch(				const DriverTable& registry_drivers,
+									const std::vector<DriverPatch>& patches,
+									std::pmr::memory_resource* memory = nullptr);
 
 } // namespace ImportEngine
\ No newline at end of file
@@ -0,0 +1,332 @@
+#include "IncrementalExport.h"
+#include "RegistryManager.h"
+#include "MappedFile.h"
+#include "CSV.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Private helper functions for IncrementalExport
+namespace
+{
+	constexpr std::uint32_t STATE_MAGIC = 0x53584C51;		// "QLXS"
+	constexpr std::uint32_t STATE_VERSION = 1;
+
+	struct StateHeader
+	{
+		std::uint32_t	magic;
+		std::uint32_t	version;
+		std::uint64_t	csv_size;			// CSV the entries describe...
+		std::int64_t	csv_time;			// ...and its last-write time
+		std::uint64_t	entry_count;
+	};
+
+	// Fixed part of one entry; the key name (UTF-16) follows it
+	struct StateEntry
+	{
+		std::uint64_t	last_write;			// RegistryManager::EnumerateDriverKeys stamp
+		std::uint64_t	offset;				// Driver's rows in the CSV
+		std::uint64_t	length;
+		std::uint32_t	key_length;			// In characters
+		std::uint32_t	reserved;
+	};
+
+	struct DriverState
+	{
+		std::uint64_t	last_write = 0;
+		std::uint64_t	offset = 0;
+		std::uint64_t	length = 0;
+	};
+
+	using StateMap = std::unordered_map<std::wstring, DriverState>;
+
+	std::wstring state_path(const std::wstring& csv_path)
+	{
+		return csv_path + L".qlxstate";
+	}
+
+	// Size and last-write time of a file, or false if it does not exist
+	bool file_stamp(const std::wstring& path, std::uint64_t& size, std::int64_t& time)
+	{
+		std::error_code ec;
+		const std::uintmax_t file_size = fs::file_size(fs::path(path), ec);
+		if (ec)
+			return false;
+
+		const fs::file_time_type file_time = fs::last_write_time(fs::path(path), ec);
+		if (ec)
+			return false;
+
+		size = file_size;
+		time = static_cast<std::int64_t>(file_time.time_since_epoch().count());
+		return true;
+	}
+
+	// Load the sidecar; empty if missing, damaged, or written for a different CSV
+	StateMap load_state(const std::wstring& csv_path)
+	{
+		StateMap state;
+
+		std::uint64_t csv_size = 0;
+		std::int64_t csv_time = 0;
+		if (!file_stamp(csv_path, csv_size, csv_time))
+			return state;
+
+		std::ifstream file(fs::path(state_path(csv_path)), std::ios::binary);
+		if (!file.is_open())
+			return state;
+
+		StateHeader header = {};
+		if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+			header.magic != STATE_MAGIC ||
+			header.version != STATE_VERSION ||
+			header.csv_size != csv_size ||
+			header.csv_time != csv_time)
+		{
+			return state;
+		}
+
+		std::wstring key;
+		for (std::uint64_t i = 0; i < header.entry_count; ++i)
+		{
+			StateEntry entry = {};
+			if (!file.read(reinterpret_cast<char*>(&entry), sizeof(entry)) ||
+				entry.key_length > 256 ||
+				entry.offset + entry.length > csv_size)
+			{
+				state.clear();
+				return state;
+			}
+
+			key.resize(entry.key_length);
+			if (!file.read(reinterpret_cast<char*>(&key[0]), static_cast<std::streamsize>(key.size() * sizeof(wchar_t))))
+			{
+				state.clear();
+				return state;
+			}
+
+			state[key] = { entry.last_write, entry.offset, entry.length };
+		}
+
+		return state;
+	}
+
+	// Write the sidecar for the CSV just written (temp file + rename, like the CSV)
+	bool save_state(		const std::wstring& csv_path,
+							const std::vector<std::wstring>& keys,
+							const std::vector<DriverState>& drivers)
+	{
+		StateHeader header = { STATE_MAGIC, STATE_VERSION, 0, 0, keys.size() };
+		if (!file_stamp(csv_path, header.csv_size, header.csv_time))
+			return false;
+
+		const fs::path path(state_path(csv_path));
+		fs::path temp = path;
+		temp += L".tmp";
+
+		{
+			std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+			if (!file.is_open())
+				return false;
+
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			for (std::size_t i = 0; i < keys.size(); ++i)
+			{
+				const StateEntry entry = { drivers[i].last_write, drivers[i].offset, drivers[i].length,
+										   static_cast<std::uint32_t>(keys[i].size()), 0 };
+				file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+				file.write(reinterpret_cast<const char*>(keys[i].data()), static_cast<std::streamsize>(keys[i].size() * sizeof(wchar_t)));
+			}
+
+			if (!file)
+			{
+				file.close();
+				std::error_code ec;
+				fs::remove(temp, ec);
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		fs::rename(temp, path, ec);
+		return !ec;
+	}
+
+	// Forget the sidecar (used whenever the CSV no longer matches it)
+	void remove_state(const std::wstring& csv_path)
+	{
+		std::error_code ec;
+		fs::remove(fs::path(state_path(csv_path)), ec);
+	}
+
+	// Replace path with the finished temp file; on failure the temp file is removed
+	bool replace_file(const std::wstring& temp_path, const std::wstring& path, std::wstring& error)
+	{
+		std::error_code ec;
+		fs::rename(fs::path(temp_path), fs::path(path), ec);
+		if (ec)
+		{
+			fs::remove(fs::path(temp_path), ec);
+			error = L"Failed to replace file: " + path;
+			return false;
+		}
+		return true;
+	}
+
+	// Export only the drivers matching filter. The filter is applied during
+	// enumeration, so rejected drivers are never fully read from the registry.
+	IncrementalExport::ExportResult export_filtered(	const std::wstring& path,
+													const DriverFilter& filter)
+	{
+		IncrementalExport::ExportResult result;
+
+		const std::wstring temp_path = path + L".tmp";
+		CSV::DriverWriter writer;
+		bool opened = false;
+
+		result.reread = RegistryManager::EnumerateDrivers([&](EthDriver& driver)
+			{
+				if (!opened && !(opened = writer.open(temp_path, result.error)))
+					return false;
+
+				writer.write(driver);
+				return true;
+			}, filter);
+
+		if (!opened)
+		{
+			// No matching drivers (nothing written), or the file could not be created
+			result.reread = 0;
+			result.success = result.error.empty();
+			return result;
+		}
+
+		if (!writer.close(result.error))
+		{
+			std::error_code ec;
+			fs::remove(fs::path(temp_path), ec);
+			result.success = false;
+			return result;
+		}
+
+		// The file no longer holds every driver; the next export must not reuse it
+		remove_state(path);
+		result.success = replace_file(temp_path, path, result.error);
+		return result;
+	}
+}	// anonymous namespace
+
+
+namespace IncrementalExport
+{
+
+	DriverSource registry_source()
+	{
+		DriverSource source;
+		source.enumerate_keys = [](const DriverSource::KeyCallback& onKey)
+			{
+				RegistryManager::EnumerateDriverKeys([&onKey](const std::wstring& key_name, ULONGLONG last_write)
+					{
+						return onKey(key_name, last_write);
+					});
+			};
+		source.load_driver = &RegistryManager::LoadDriver;
+		return source;
+	}
+
+	ExportResult export_drivers(			const std::wstring& path,
+											const DriverFilter& filter)
+	{
+		if (!filter.is_empty())
+			return export_filtered(path, filter);
+
+		return export_drivers(path, registry_source());
+	}
+
+	ExportResult export_drivers(			const std::wstring& path,
+											const DriverSource& source)
+	{
+		ExportResult result;
+
+		// Previous export, if its sidecar still describes it
+		const StateMap previous = load_state(path);
+		MappedFile previous_csv;
+		if (!previous.empty() && previous_csv.Open(path) != ERROR_SUCCESS)
+			previous_csv.Close();
+
+		// Build the new export next to the old one, then swap it in
+		const std::wstring temp_path = path + L".tmp";
+
+		std::vector<std::wstring> keys;
+		std::vector<DriverState> drivers;
+
+		CSV::DriverWriter writer;
+		bool opened = false;
+		EthDriver driver;
+
+		source.enumerate_keys([&](const std::wstring& key_name, std::uint64_t last_write)
+			{
+				// Same key, same stamp: its rows in the old CSV are still current
+				const auto found = previous_csv.IsOpen() ? previous.find(key_name) : previous.end();
+				const bool reuse = (found != previous.end() && found->second.last_write == last_write);
+
+				if (!reuse && !source.load_driver(key_name, driver))
+					return true;	// Skip keys a full export would skip
+
+				if (!opened && !(opened = writer.open(temp_path, result.error)))
+					return false;
+
+				const std::uint64_t offset = writer.position();
+				if (reuse)
+				{
+					writer.write_rows(previous_csv.View().substr(static_cast<std::size_t>(found->second.offset),
+																 static_cast<std::size_t>(found->second.length)));
+					++result.reused;
+				}
+				else
+				{
+					writer.write(driver);
+					++result.reread;
+				}
+
+				keys.push_back(key_name);
+				drivers.push_back({ last_write, offset, writer.position() - offset });
+				return true;
+			});
+
+		if (!opened)
+		{
+			// No drivers (nothing written), or the file could not be created
+			result.success = result.error.empty();
+			return result;
+		}
+
+		if (!writer.close(result.error))
+		{
+			std::error_code ec;
+			fs::remove(fs::path(temp_path), ec);
+			result.success = false;
+			return result;
+		}
+
+		// Release the old file before replacing it
+		previous_csv.Close();
+		remove_state(path);
+
+		if (!replace_file(temp_path, path, result.error))
+		{
+			result.success = false;
+			return result;
+		}
+
+		// Losing the sidecar only costs the next export a full re-read
+		save_state(path, keys, drivers);
+		return result;
+	}
+
+} // namespace IncrementalExport
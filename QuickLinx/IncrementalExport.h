@@ -0,0 +1,76 @@
+#pragma once
+
+#include "DriverFilter.h"
+#include "EthDriver.h"
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+/*
+	File: IncrementalExport.h
+
+	Description:
+		Exports all AB_ETH-x drivers to CSV, re-reading from the registry
+		only the drivers whose keys changed since the previous export to
+		the same file.
+
+		Next to the CSV a small sidecar file (<csv>.qlxstate) records, for
+		every driver key, its last-write stamp and where its rows sit in
+		the CSV. On the next export, drivers with an unchanged stamp have
+		their rows copied straight from the old file; only changed or new
+		keys are read and formatted. Deleted keys simply drop out.
+
+		A filtered export (see DriverFilter) streams only the matching
+		drivers and leaves no sidecar, so the next full export to the
+		same file re-reads everything.
+
+		The result is always a complete export, byte for byte what a full
+		export would write. If the sidecar is missing or the CSV was
+		modified since, everything is re-read.
+
+		Drivers normally come from the registry (RegistryManager); the
+		DriverSource overload takes them from anywhere else, which is
+		how the tests drive it.
+*/
+
+namespace IncrementalExport
+{
+	struct ExportResult
+	{
+		std::size_t					reused = 0;				// Drivers copied from the previous export
+		std::size_t					reread = 0;				// Drivers read from the registry
+
+		std::wstring				error;					// Set when success is false
+
+		bool						success = true;			// Success flag
+	};
+
+	// Where an unfiltered export reads driver keys and drivers from
+	struct DriverSource
+	{
+		using KeyCallback = std::function<bool(const std::wstring& key_name, std::uint64_t last_write)>;
+
+		// Visit every driver key with a stamp that changes whenever the driver
+		// does (see RegistryManager::EnumerateDriverKeys); stop if onKey returns false
+		std::function<void(const KeyCallback& onKey)>							enumerate_keys;
+
+		// Read one driver; false skips the key, as a full export would
+		std::function<bool(const std::wstring& key_name, EthDriver& driver)>	load_driver;
+	};
+
+	// The live registry
+	DriverSource registry_source();
+
+	// Export to path, reusing unchanged drivers from the previous export.
+	// With a non-empty filter only matching drivers are exported (all re-read).
+	// No file is written if no driver is exported (reused + reread == 0).
+	ExportResult export_drivers(			const std::wstring& path,
+											const DriverFilter& filter = DriverFilter());
+
+	// The same unfiltered export, reading drivers from source
+	ExportResult export_drivers(			const std::wstring& path,
+											const DriverSource& source);
+
+} // namespace IncrementalExport
@@ -0,0 +1,179 @@
+#include "MappedFile.h"
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+#ifdef _WIN32
+
+//------------------------------------------------------
+// Map an existing file read-only
+//------------------------------------------------------
+LONG MappedFile::Open(		const std::wstring& path) noexcept
+{
+	// Close any existing mapping first
+	Close();
+
+	HANDLE file = ::CreateFileW(
+		path.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ | FILE_SHARE_WRITE,		// same sharing the old stream reader allowed
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+		nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return static_cast<LONG>(::GetLastError());
+
+	LARGE_INTEGER file_size = {};
+	if (!::GetFileSizeEx(file, &file_size))
+	{
+		const LONG error = static_cast<LONG>(::GetLastError());
+		::CloseHandle(file);
+		return error;
+	}
+
+	m_file = file;
+
+	// CreateFileMapping rejects zero-length files; an empty file is just an empty view.
+	if (file_size.QuadPart == 0)
+		return ERROR_SUCCESS;
+
+	HANDLE mapping = ::CreateFileMappingW(
+		file,
+		nullptr,		// security attributes
+		PAGE_READONLY,
+		0,				// map the whole file
+		0,
+		nullptr);		// unnamed
+
+	if (mapping == nullptr)
+	{
+		const LONG error = static_cast<LONG>(::GetLastError());
+		Close();
+		return error;
+	}
+
+	m_mapping = mapping;
+
+	const void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr)
+	{
+		const LONG error = static_cast<LONG>(::GetLastError());
+		Close();
+		return error;
+	}
+
+	m_data = static_cast<const char*>(view);
+	m_size = static_cast<std::size_t>(file_size.QuadPart);
+
+	return ERROR_SUCCESS;
+}
+
+//------------------------------------------------------
+// Explicit close
+//------------------------------------------------------
+void MappedFile::Close() noexcept
+{
+	if (m_data != nullptr)
+	{
+		::UnmapViewOfFile(m_data);
+		m_data = nullptr;
+	}
+	m_size = 0;
+
+	if (m_mapping != nullptr)
+	{
+		::CloseHandle(m_mapping);
+		m_mapping = nullptr;
+	}
+
+	if (m_file != INVALID_HANDLE_VALUE)
+	{
+		::CloseHandle(m_file);
+		m_file = INVALID_HANDLE_VALUE;
+	}
+}
+
+#else
+
+#include <filesystem>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//------------------------------------------------------
+// Map an existing file read-only (POSIX)
+//------------------------------------------------------
+LONG MappedFile::Open(		const std::wstring& path) noexcept
+{
+	Close();
+
+	std::string native;
+	try
+	{
+		native = std::filesystem::path(path).string();
+	}
+	catch (...)
+	{
+		return EINVAL;
+	}
+
+	const int fd = ::open(native.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return errno;
+
+	struct stat info = {};
+	if (::fstat(fd, &info) != 0)
+	{
+		const LONG error = errno;
+		::close(fd);
+		return error;
+	}
+
+	m_fd = fd;
+
+	// mmap rejects zero-length mappings; an empty file is just an empty view.
+	if (info.st_size == 0)
+		return ERROR_SUCCESS;
+
+	void* view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	if (view == MAP_FAILED)
+	{
+		const LONG error = errno;
+		Close();
+		return error;
+	}
+
+	::madvise(view, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+
+	m_data = static_cast<const char*>(view);
+	m_size = static_cast<std::size_t>(info.st_size);
+
+	return ERROR_SUCCESS;
+}
+
+//------------------------------------------------------
+// Explicit close (POSIX)
+//------------------------------------------------------
+void MappedFile::Close() noexcept
+{
+	if (m_data != nullptr)
+	{
+		::munmap(const_cast<char*>(m_data), m_size);
+		m_data = nullptr;
+	}
+	m_size = 0;
+
+	if (m_fd != -1)
+	{
+		::close(m_fd);
+		m_fd = -1;
+	}
+}
+
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+using LONG = long;					// errno values stand in for Win32 error codes
+#ifndef ERROR_SUCCESS
+#define ERROR_SUCCESS 0L
+#endif
+#endif
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+/*
+	File: MappedFile.h
+
+	Description:
+		A simple RAII wrapper around a read-only memory-mapped file.
+
+		Makes use of Windows API functions such as:
+			* CreateFile
+			* CreateFileMapping
+			* MapViewOfFile
+			* UnmapViewOfFile
+
+		Other platforms (offline tools) use open/mmap and return errno
+		values in place of Win32 error codes.
+
+		The mapped bytes stay valid until Close() is called or the
+		MappedFile object goes out of scope.
+*/
+
+
+class MappedFile {
+public:
+	MappedFile() noexcept = default;
+	~MappedFile();
+
+	// Non-copyable (prevents double unmapping)
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Map an existing file (read only). Returns ERROR_SUCCESS or a Win32 error code.
+	LONG Open(			const std::wstring& path) noexcept;
+
+	// Check if open
+#ifdef _WIN32
+	bool IsOpen() const noexcept { return m_file != INVALID_HANDLE_VALUE; }
+#else
+	bool IsOpen() const noexcept { return m_fd != -1; }
+#endif
+
+	// Explicitly unmap and close if still open
+	void Close() noexcept;
+
+	// Raw file contents. Empty files map to an empty view.
+	const char* Data() const noexcept { return m_data; }
+	std::size_t Size() const noexcept { return m_size; }
+	std::string_view View() const noexcept { return std::string_view(m_data, m_size); }
+
+private:
+#ifdef _WIN32
+	HANDLE		m_file = INVALID_HANDLE_VALUE;
+	HANDLE		m_mapping = nullptr;
+#else
+	int			m_fd = -1;
+#endif
+	const char*	m_data = nullptr;
+	std::size_t	m_size = 0;
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/*
+	File: NodeList.h
+
+	Description:
+		The Node Table of one driver as packed IPv4 addresses (host order,
+		10.0.0.1 = 0x0A000001), stored inline with room for the 254 nodes
+		an AB_ETH driver can hold.
+
+		Nodes stay numeric everywhere inside QuickLinx and are only
+		turned into text at the CSV and registry boundaries, so a driver
+		costs one fixed block instead of one heap string per node, and
+		comparing nodes is comparing integers.
+
+		Order is kept as inserted. Lookups are linear scans over at most
+		1 KB of integers, which beats hashing at this size.
+*/
+
+class NodeList {
+
+public:
+	static constexpr std::size_t CAPACITY = 254;			// Most nodes an AB_ETH driver can hold
+
+	using value_type = std::uint32_t;
+	using iterator = std::uint32_t*;
+	using const_iterator = const std::uint32_t*;
+
+	NodeList() noexcept = default;
+
+	// Copies only the addresses in use
+	NodeList(const NodeList& other) noexcept
+		: m_size(other.m_size)
+	{
+		std::copy(other.begin(), other.end(), m_items);
+	}
+
+	NodeList& operator=(const NodeList& other) noexcept
+	{
+		m_size = other.m_size;
+		std::copy(other.begin(), other.end(), m_items);
+		return *this;
+	}
+
+	std::size_t size() const noexcept { return m_size; }
+	bool empty() const noexcept { return m_size == 0; }
+	bool full() const noexcept { return m_size == CAPACITY; }
+	static constexpr std::size_t capacity() noexcept { return CAPACITY; }
+
+	iterator begin() noexcept { return m_items; }
+	iterator end() noexcept { return m_items + m_size; }
+	const_iterator begin() const noexcept { return m_items; }
+	const_iterator end() const noexcept { return m_items + m_size; }
+	const std::uint32_t* data() const noexcept { return m_items; }
+
+	std::uint32_t operator[](std::size_t index) const noexcept { return m_items[index]; }
+
+	// Append an address. Returns false (and changes nothing) when full.
+	bool push_back(std::uint32_t address) noexcept
+	{
+		if (full())
+			return false;
+		m_items[m_size++] = address;
+		return true;
+	}
+
+	// Replace the contents. Returns false if [first, last) did not all fit.
+	template <typename It>
+	bool assign(It first, It last) noexcept
+	{
+		clear();
+		for (; first != last; ++first)
+		{
+			if (!push_back(static_cast<std::uint32_t>(*first)))
+				return false;
+		}
+		return true;
+	}
+
+	bool contains(std::uint32_t address) const noexcept
+	{
+		return std::find(begin(), end(), address) != end();
+	}
+
+	// Remove the first occurrence, keeping the order of the rest
+	bool remove(std::uint32_t address) noexcept
+	{
+		const iterator found = std::find(begin(), end(), address);
+		if (found == end())
+			return false;
+
+		std::copy(found + 1, end(), found);
+		--m_size;
+		return true;
+	}
+
+	void clear() noexcept { m_size = 0; }
+
+	bool operator==(const NodeList& other) const noexcept
+	{
+		return std::equal(begin(), end(), other.begin(), other.end());
+	}
+
+	bool operator!=(const NodeList& other) const noexcept { return !(*this == other); }
+
+private:
+	std::uint32_t		m_size = 0;
+	std::uint32_t		m_items[CAPACITY];			// Only [0, m_size) is meaningful
+
+};
@@ -2,65 +2,17 @@
 #include "RegistryManager.h"
 #include "CSV.h"
 #include "ImportEngine.h"
+#include "IncrementalExport.h"
 
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QDir>
-#include <QDebug>
+#include <QStandardPaths>
 
 #include <windows.h>
-#include <io.h>
-#include <fcntl.h>
-#include <iostream>
 
-static void AttachConsole()
-{
-    static bool attached = false;
-    if (attached)
-        return;
-
-    if (AllocConsole())
-    {
-        attached = true;
-
-        // Redirect stdin/stdout/stderr to the new console
-        FILE* fp;
-        freopen_s(&fp, "CONIN$", "r", stdin);
-        freopen_s(&fp, "CONOUT$", "w", stdout);
-        freopen_s(&fp, "CONOUT$", "w", stderr);
-
-        // Make std::wcout use UTF-16 so your std::wstring prints nicely
-        _setmode(_fileno(stdout), _O_U16TEXT);
-    }
-}
-
-static void ClearConsole() { std::system("cls"); }
-
-static void DumpDriversToConsole(const std::vector<EthDriver>& drivers)
-{
-    AttachConsole();
-	//ClearConsole();
-
-    qDebug().noquote() << "========== Parsed EthDriver list ==========";
-
-    for (const auto& d : drivers)
-    {
-        qDebug().noquote()
-            << "Driver:" << QString::fromStdWString(d.name)
-            << "| key_name:" << QString::fromStdWString(d.key_name)
-            << "| station:" << d.station
-            << "| nodes:" << d.nodes.size();
-
-        for (size_t i = 0; i < d.nodes.size(); ++i)
-        {
-            qDebug().noquote()
-                << "   [" << i << "]"
-                << QString::fromStdWString(d.nodes[i]);
-        }
-    }
-
-    qDebug().noquote() << "===========================================";
-}
+// Most CSV problems listed in the import error dialog
+static constexpr std::size_t CSV_ERRORS_SHOWN = 50;
 
 QuickLinx::QuickLinx(QWidget *parent)
     : QMainWindow(parent)
@@ -87,6 +39,21 @@ QuickLinx::~QuickLinx()
 // Button Event Handlers
 void QuickLinx::on_export_button_clicked()
 {
+	// 0. Optional filter from the export options (empty = every driver).
+	DriverFilter filter;
+	std::wstring filter_error;
+	if (!DriverFilter::parse(	ui.name_filter_edit->text().toStdWString(),
+								ui.subnet_filter_edit->text().toStdWString(),
+								filter,
+								filter_error))
+	{
+		QMessageBox::warning(
+			this,
+			"Export Filter",
+			QString::fromStdWString(filter_error));
+		return;
+	}
+
 	// 1. Ask user where to save the CSV file.
 	QString default_path = QDir::homePath() + "/QuickLinx_Export.csv";
 
@@ -104,23 +71,55 @@ void QuickLinx::on_export_button_clicked()
     ui.status_label->setText("Exporting...");
     update_progress_bar(0, 1);
 
-	// 2. Load drivers from registry.
-	std::vector<EthDriver> drivers = RegistryManager::LoadDrivers();
-    if (drivers.empty())
+	// 2. Export. By default drivers stream from the registry straight into
+	//    the CSV file, which is only created once the first driver has been
+	//    read. The incremental option re-reads only drivers changed since the
+	//    last export to this file, and keeps a <csv>.qlxstate sidecar for it.
+	//    A filter is applied while the registry is enumerated, either way.
+	const std::wstring path = file_name.toStdWString();
+	std::size_t exported = 0;
+	std::wstring error;
+	bool written = false;
+
+	if (ui.incremental_checkbox->isChecked())
+	{
+		const IncrementalExport::ExportResult result = IncrementalExport::export_drivers(path, filter);
+		exported = result.reused + result.reread;
+		error = result.error;
+		written = result.success;
+	}
+	else
+	{
+		CSV::DriverWriter writer;
+		bool opened = false;
+
+		exported = RegistryManager::EnumerateDrivers([&](EthDriver& driver)
+			{
+				if (!opened && !(opened = writer.open(path, error)))
+					return false;
+
+				writer.write(driver);
+				return true;
+			}, filter);
+
+		// Not opened and no error: the registry had no drivers (reported below)
+		written = opened ? writer.close(error) : error.empty();
+	}
+
+    if (written && exported == 0)
     {
         QMessageBox::warning(
             this,
             "Export Failed",
-			"No AB_ETH drivers found in the Registry to export.");
+			filter.is_empty()
+				? "No AB_ETH drivers found in the Registry to export."
+				: "No AB_ETH drivers in the Registry match the export filter.");
 		ui.status_label->setText("Export failed: No drivers found.");
         return;
     }
 
-	DumpDriversToConsole(drivers);
-
-	// 3. Export to CSV.
-    std::wstring error;
-    if (!CSV::write_drivers_to_file(file_name.toStdWString(), drivers, error))
+	// 3. Report write errors.
+    if (!written)
     {
         QMessageBox::critical(
             this,
@@ -140,36 +139,49 @@ void QuickLinx::on_export_button_clicked()
 
 void QuickLinx::on_import_button_clicked()
 {
-    QString file_name = QFileDialog::getOpenFileName(
+    QStringList file_names = QFileDialog::getOpenFileNames(
         this, 
         "Import QuickLinx Drivers from CSV",
         QDir::homePath(),
 		"CSV Files (*.csv);;All Files (*)");
 
-    if (file_name.isEmpty())
+    if (file_names.isEmpty())
         return;
 
 	ui.status_label->setText("Validating Format...");
     update_progress_bar(0, 1);
 
-	std::wstring error;
+	// Collect every problem in the files in one pass
+	Diagnostics::List errors(CSV_ERRORS_SHOWN);
 
-    if (!CSV::read_drivers_from_file(file_name.toStdWString(), m_csv_drivers, error))
+	// Re-imports of a large master file only re-parse the chunks that changed
+	CSV::ReadOptions options;
+	options.cache_dir = QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+							.filePath("csv-chunks").toStdWString();
+
+	// Site files are parsed concurrently; a driver defined in two files is an error
+	std::vector<std::wstring> paths;
+	for (const QString& file_name : file_names)
+		paths.push_back(file_name.toStdWString());
+
+	std::vector<EthDriver> csv_drivers;
+	m_csv_drivers.clear();
+    if (!CSV::read_drivers_from_files(paths, csv_drivers, errors, CSV::ConflictPolicy::Error, options))
     {
         QMessageBox::critical(
             this,
             "Import Failed",
-            QString::fromWCharArray(error.c_str()));
+            QString::fromStdWString(errors.format_all()));
 
 		ui.status_label->setText("Import failed. CSV error.");
         update_progress_bar(0, 1);
         return;
     }
 
-	//DumpDriversToConsole(drivers);
-
-	// Successful read - Dont touch Registry yet.
-    QString summary = QString("Parsed %1 driver(s) from CSV. Ready for Import").arg(m_csv_drivers.size());
+	// Successful read - Dont touch Registry yet. Merge and overwrite both use the table.
+	m_csv_drivers = DriverTable(csv_drivers);
+    QString summary = QString("Parsed %1 driver(s) from %2 CSV file(s). Ready for Import")
+							.arg(m_csv_drivers.size()).arg(file_names.size());
 
     QMessageBox::information(this, "Import Test OK", summary);
 	ui.status_label->setText("Import Successful! Ready to Merge/Overwrite");
@@ -191,7 +203,8 @@ void QuickLinx::on_merge_button_clicked()
     }
 
 	// Load existing drivers from registry
-	auto registry_drivers = RegistryManager::LoadDrivers();
+	DriverTable registry_drivers;
+	RegistryManager::LoadDrivers(registry_drivers);
     if (registry_drivers.empty())
     {
         QMessageBox::warning(
@@ -237,7 +250,7 @@ void QuickLinx::on_merge_button_clicked()
             if (!RegistryManager::SaveDriver(drv)) 
             {
 				all_ok = false;
-				save_errors += L"Failed to save driver: " + drv.name + L"' (" + drv.key_name + L")\n";
+				save_errors += L"Failed to save driver: " + drv.name.str() + L"' (" + drv.key_name.str() + L")\n";
             }
 			++saved_count;
 			update_progress_bar(static_cast<int>(saved_count), static_cast<int>(total_to_save));
@@ -260,8 +273,7 @@ void QuickLinx::on_merge_button_clicked()
 
     if (!result.errors.empty())
     {
-        for(const auto& e : result.errors)
-			details += QString::fromStdWString(e) + "\n";
+		details += QString::fromStdWString(result.errors.format_all());
     }
     if (!save_errors.empty())
     {
@@ -303,7 +315,8 @@ void QuickLinx::on_overwrite_button_clicked()
         return;
     }
 
-    auto registry_drivers = RegistryManager::LoadDrivers();
+    DriverTable registry_drivers;
+    RegistryManager::LoadDrivers(registry_drivers);
     if (registry_drivers.empty())
     {
         QMessageBox::warning(
@@ -352,8 +365,8 @@ void QuickLinx::on_overwrite_button_clicked()
         if (!RegistryManager::SaveDriver(d))
         {
             all_ok = false;
-            save_errors += L"Failed to save driver '" + d.name +
-                L"' (" + d.key_name + L")\n";
+            save_errors += L"Failed to save driver '" + d.name.str() +
+                L"' (" + d.key_name.str() + L")\n";
         }
         bump_progress();
     }
@@ -364,8 +377,8 @@ void QuickLinx::on_overwrite_button_clicked()
         if (!RegistryManager::SaveDriver(d))
         {
             all_ok = false;
-            save_errors += L"Failed to save new driver '" + d.name +
-                L"' (" + d.key_name + L")\n";
+            save_errors += L"Failed to save new driver '" + d.name.str() +
+                L"' (" + d.key_name.str() + L")\n";
         }
         bump_progress();
     }
@@ -378,8 +391,7 @@ void QuickLinx::on_overwrite_button_clicked()
 
     // Final status / errors
     QString details;
-    for (const auto& e : result.errors)
-        details += QString::fromStdWString(e) + "\n";
+    details += QString::fromStdWString(result.errors.format_all());
     if (!save_errors.empty())
         details += QString::fromStdWString(save_errors);
 
@@ -4,6 +4,7 @@
 #include "ui_QuickLinx.h"
 
 #include "EthDriver.h"
+#include "DriverTable.h"
 
 class QuickLinx : public QMainWindow
 {
@@ -23,6 +24,6 @@ private slots:
 
 private:
     Ui::QuickLinxClass ui;
-	std::vector<EthDriver> m_csv_drivers;
+	DriverTable m_csv_drivers;		// Staged by import, in the form ImportEngine works on
 };
 
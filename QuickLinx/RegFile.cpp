@@ -0,0 +1,905 @@
+#include "RegFile.h"
+#include "RegistryLayout.h"
+#include "MappedFile.h"
+#include "CSVEncoding.h"
+#include "IPv4.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <unordered_map>
+
+// Private helper functions for RegFile
+namespace
+{
+	constexpr std::wstring_view FILE_HEADER = L"Windows Registry Editor Version 5.00\r\n\r\n";
+	constexpr std::wstring_view LINE_END = L"\r\n";
+
+	constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+	constexpr std::wstring_view REGEDIT5_HEADER = L"Windows Registry Editor Version 5.00";
+	constexpr std::wstring_view REGEDIT4_HEADER = L"REGEDIT4";
+
+	inline wchar_t ascii_lower(wchar_t c) noexcept
+	{
+		return (c >= L'A' && c <= L'Z') ? static_cast<wchar_t>(c + (L'a' - L'A')) : c;
+	}
+
+	// Registry key and value names compare case-insensitively
+	bool iequals(std::wstring_view a, std::wstring_view b) noexcept
+	{
+		if (a.size() != b.size())
+			return false;
+		for (std::size_t i = 0; i < a.size(); ++i)
+		{
+			if (ascii_lower(a[i]) != ascii_lower(b[i]))
+				return false;
+		}
+		return true;
+	}
+
+	bool istarts_with(std::wstring_view s, std::wstring_view prefix) noexcept
+	{
+		return s.size() >= prefix.size() && iequals(s.substr(0, prefix.size()), prefix);
+	}
+
+	std::wstring_view trim(std::wstring_view s) noexcept
+	{
+		while (!s.empty() && (s.front() == L' ' || s.front() == L'\t'))
+			s.remove_prefix(1);
+		while (!s.empty() && (s.back() == L' ' || s.back() == L'\t' || s.back() == L'\r'))
+			s.remove_suffix(1);
+		return s;
+	}
+
+	int hex_value(wchar_t c) noexcept
+	{
+		if (c >= L'0' && c <= L'9') return c - L'0';
+		c = ascii_lower(c);
+		if (c >= L'a' && c <= L'f') return c - L'a' + 10;
+		return -1;
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: decode_file
+
+		Desc: Widens a whole .reg file. regedit 5.00 writes UTF-16LE
+			  with a BOM; REGEDIT4 files are 8-bit text.
+		-----------------------------------------------------------------
+	*/
+	void decode_file(std::string_view bytes, std::wstring& text)
+	{
+		using CSV::Encoding::Kind;
+
+		const CSV::Encoding::Detected detected = CSV::Encoding::detect(bytes);
+		bytes.remove_prefix(detected.bom_size);
+
+		if (detected.kind != Kind::UTF16LE && detected.kind != Kind::UTF16BE)
+		{
+			text = CSV::Encoding::to_wide(bytes, detected.kind);
+			return;
+		}
+
+		const bool big_endian = (detected.kind == Kind::UTF16BE);
+		const unsigned char* b = reinterpret_cast<const unsigned char*>(bytes.data());
+		const std::size_t units = bytes.size() / 2;
+		auto unit_at = [&](std::size_t i) -> std::uint32_t
+			{
+				return big_endian ? (std::uint32_t(b[2 * i]) << 8) | b[2 * i + 1]
+								  : (std::uint32_t(b[2 * i + 1]) << 8) | b[2 * i];
+			};
+
+		text.clear();
+		text.reserve(units);
+		for (std::size_t i = 0; i < units; ++i)
+		{
+			std::uint32_t unit = unit_at(i);
+
+			// Where wchar_t is UTF-32, join surrogate pairs
+			if (sizeof(wchar_t) > 2 && unit >= 0xD800 && unit <= 0xDBFF && i + 1 < units)
+			{
+				const std::uint32_t low = unit_at(i + 1);
+				if (low >= 0xDC00 && low <= 0xDFFF)
+				{
+					unit = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+					++i;
+				}
+			}
+			text.push_back(static_cast<wchar_t>(unit));
+		}
+	}
+
+	/*	-----------------------------------------------------------------
+		Class: SnapshotParser
+
+		Desc: Rebuilds the AB_ETH drivers from the text of one .reg file,
+			  applying its sections in order the way "reg import" would:
+			  [key] creates or reopens a key, [-key] deletes it, and
+			  "value"=- deletes a value. Only the driver keys and their
+			  Node Tables are kept; everything else is skipped.
+
+			  Strings are parsed into reused buffers, so the only
+			  allocations are the drivers themselves.
+		-----------------------------------------------------------------
+	*/
+	class SnapshotParser
+	{
+	public:
+		explicit SnapshotParser(std::wstring_view text)
+			: m_text(text)
+		{}
+
+		// False if the text is not a .reg file
+		bool parse(std::vector<EthDriver>& drivers_out);
+
+	private:
+		enum class Section { Other, Driver, NodeTable };
+
+		enum class ValueType { Deleted, String, Dword, Other };
+
+		struct PendingDriver
+		{
+			EthDriver	driver{};
+			bool		has_name = false;
+			bool		has_station = false;
+			bool		deleted = false;
+		};
+
+		bool next_line(std::wstring_view& line);
+		void key_line(std::wstring_view key);
+		void value_line(std::wstring_view line);
+		ValueType value_data(std::wstring_view data);
+		void hex_data(std::wstring_view data);
+		std::size_t find_driver(std::wstring_view key_name, bool create);
+
+		// "..." with \ and \" escapes, from just after the opening quote.
+		// Returns what follows the closing quote.
+		static std::wstring_view unquote(std::wstring_view s, std::wstring& out);
+
+		static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+		std::wstring_view							m_text;
+		std::size_t									m_pos = 0;
+
+		std::vector<PendingDriver>					m_drivers;
+		std::unordered_map<DriverName, std::size_t,
+			std::hash<DriverName>, DriverName::CaseInsensitiveEqual>	m_index;
+
+		Section										m_section = Section::Other;
+		std::size_t									m_current = NONE;
+
+		std::wstring								m_name;				// Reused per value line
+		std::wstring								m_string;
+		std::vector<unsigned char>					m_bytes;
+		DWORD										m_dword = 0;
+	};
+
+	bool SnapshotParser::next_line(std::wstring_view& line)
+	{
+		if (m_pos >= m_text.size())
+			return false;
+
+		std::size_t end = m_text.find(L'\n', m_pos);
+		if (end == std::wstring_view::npos)
+			end = m_text.size();
+
+		line = trim(m_text.substr(m_pos, end - m_pos));
+		m_pos = end + 1;
+		return true;
+	}
+
+	bool SnapshotParser::parse(std::vector<EthDriver>& drivers_out)
+	{
+		std::wstring_view line;
+		while (next_line(line) && line.empty())
+		{}
+
+		if (line != REGEDIT5_HEADER && line != REGEDIT4_HEADER)
+			return false;
+
+		while (next_line(line))
+		{
+			if (line.empty() || line.front() == L';')
+				continue;
+
+			if (line.front() == L'[')
+			{
+				if (line.back() == L']')
+					key_line(line.substr(1, line.size() - 2));
+				else
+					m_section = Section::Other;
+			}
+			else if (m_section != Section::Other)
+			{
+				value_line(line);
+			}
+		}
+
+		// Keep what a registry read would accept, in first-seen order
+		drivers_out.clear();
+		for (PendingDriver& pending : m_drivers)
+		{
+			if (!pending.deleted && pending.has_name && pending.has_station)
+				drivers_out.push_back(std::move(pending.driver));
+		}
+		return true;
+	}
+
+	void SnapshotParser::key_line(std::wstring_view key)
+	{
+		m_section = Section::Other;
+		m_current = NONE;
+
+		const bool deleting = (!key.empty() && key.front() == L'-');
+		if (deleting)
+			key.remove_prefix(1);
+
+		// HKEY_LOCAL_MACHINE\SOFTWARE\[WOW6432Node\]Rockwell Software\RSLinx\Drivers\AB_ETH
+		const std::wstring_view root(RegistryLayout::ROOT_NAME);
+		if (!istarts_with(key, root) || key.size() == root.size() || key[root.size()] != L'\\')
+			return;
+		key.remove_prefix(root.size() + 1);
+
+		if (istarts_with(key, RegistryLayout::AB_ETH_BASE))
+			key.remove_prefix(std::wstring_view(RegistryLayout::AB_ETH_BASE).size());
+		else if (istarts_with(key, RegistryLayout::AB_ETH_BASE_NATIVE))
+			key.remove_prefix(std::wstring_view(RegistryLayout::AB_ETH_BASE_NATIVE).size());
+		else
+			return;
+
+		if (key.empty())
+		{
+			// The AB_ETH key itself; deleting it deletes every driver
+			if (deleting)
+			{
+				for (PendingDriver& pending : m_drivers)
+					pending.deleted = true;
+			}
+			return;
+		}
+
+		if (key.front() != L'\\')
+			return;
+		key.remove_prefix(1);
+
+		const std::size_t slash = key.find(L'\\');
+		const std::wstring_view key_name = key.substr(0, slash);
+		const std::wstring_view subkey = (slash == std::wstring_view::npos) ? std::wstring_view() : key.substr(slash + 1);
+		if (key_name.empty())
+			return;
+
+		const bool node_table = iequals(subkey, RegistryLayout::SUBKEY_NODE_TABLE);
+		if (!subkey.empty() && !node_table)
+			return;
+
+		const std::size_t index = find_driver(key_name, !deleting);
+		if (index == NONE)
+			return;
+
+		PendingDriver& pending = m_drivers[index];
+		if (deleting)
+		{
+			pending.driver.nodes.clear();
+			pending.driver.extra_nodes.clear();
+			if (!node_table)
+				pending.deleted = true;
+			return;
+		}
+
+		if (pending.deleted)
+		{
+			// Deleted earlier in the file, now created again
+			const DriverName key_name_copy = pending.driver.key_name;
+			pending = PendingDriver();
+			pending.driver.key_name = key_name_copy;
+		}
+
+		m_section = node_table ? Section::NodeTable : Section::Driver;
+		m_current = index;
+	}
+
+	std::size_t SnapshotParser::find_driver(std::wstring_view key_name, bool create)
+	{
+		const DriverName name(key_name);
+
+		// A Node Table section almost always follows its own driver
+		if (!m_drivers.empty() && m_drivers.back().driver.key_name.iequals(name))
+			return m_drivers.size() - 1;
+
+		const auto found = m_index.find(name);
+		if (found != m_index.end())
+			return found->second;
+		if (!create)
+			return NONE;
+
+		m_drivers.emplace_back();
+		m_drivers.back().driver.key_name = name;
+		m_index.emplace(name, m_drivers.size() - 1);
+		return m_drivers.size() - 1;
+	}
+
+	void SnapshotParser::value_line(std::wstring_view line)
+	{
+		// @=... is the key's default value, which no driver uses
+		if (line.front() != L'"')
+			return;
+
+		std::wstring_view rest = trim(unquote(line.substr(1), m_name));
+		if (rest.empty() || rest.front() != L'=')
+			return;
+
+		const ValueType type = value_data(trim(rest.substr(1)));
+		PendingDriver& pending = m_drivers[m_current];
+
+		if (m_section == Section::NodeTable)
+		{
+			// Same rules as the registry read: named string values, non-empty,
+			// packed when they are addresses
+			if (type == ValueType::String && !m_name.empty() && !m_string.empty())
+			{
+				std::uint32_t address = 0;
+				if (IPv4::parse_address(std::wstring_view(m_string), address) != IPv4::ParseError::None ||
+					!pending.driver.nodes.push_back(address))
+				{
+					const std::uint32_t before = static_cast<std::uint32_t>(pending.driver.nodes.size());
+					pending.driver.extra_nodes.push_back({ before, m_string });
+				}
+			}
+			return;
+		}
+
+		DWORD* field = nullptr;
+		bool* present = nullptr;
+		if (iequals(m_name, RegistryLayout::VAL_NAME))
+		{
+			if (type == ValueType::String || type == ValueType::Deleted)
+			{
+				// Kept even over the RSLinx limit, as the registry read does
+				pending.has_name = (type == ValueType::String);
+				if (pending.has_name)
+					pending.driver.name.assign(m_string);
+				else
+					pending.driver.name.clear();
+			}
+			return;
+		}
+		else if (iequals(m_name, RegistryLayout::VAL_STATION))
+		{
+			field = &pending.driver.station;
+			present = &pending.has_station;
+		}
+		else if (iequals(m_name, RegistryLayout::VAL_PING_TIMEOUT))
+			field = &pending.driver.ping_timeout;
+		else if (iequals(m_name, RegistryLayout::VAL_INACTIVITY))
+			field = &pending.driver.inactivity_timeout;
+		else if (iequals(m_name, RegistryLayout::VAL_STARTUP))
+			field = &pending.driver.startup;
+		else
+			return;
+
+		if (type == ValueType::Dword)
+			*field = m_dword;
+		else if (type == ValueType::Deleted)
+			*field = 0;
+		else
+			return;
+
+		if (present != nullptr)
+			*present = (type == ValueType::Dword);
+	}
+
+	// Parse the data after '=' into m_string or m_dword
+	SnapshotParser::ValueType SnapshotParser::value_data(std::wstring_view data)
+	{
+		if (data == L"-")
+			return ValueType::Deleted;
+
+		if (!data.empty() && data.front() == L'"')
+		{
+			unquote(data.substr(1), m_string);
+			return ValueType::String;
+		}
+
+		if (istarts_with(data, L"dword:"))
+		{
+			data.remove_prefix(6);
+			if (data.empty() || data.size() > 8)
+				return ValueType::Other;
+
+			DWORD value = 0;
+			for (const wchar_t c : data)
+			{
+				const int digit = hex_value(c);
+				if (digit < 0)
+					return ValueType::Other;
+				value = (value << 4) | static_cast<DWORD>(digit);
+			}
+			m_dword = value;
+			return ValueType::Dword;
+		}
+
+		// hex(2): is REG_EXPAND_SZ and hex(1): REG_SZ, both UTF-16LE bytes
+		const bool expand_sz = istarts_with(data, L"hex(2):");
+		if (!expand_sz && !istarts_with(data, L"hex(1):"))
+		{
+			// Other hex types may still run onto continuation lines
+			if (istarts_with(data, L"hex"))
+				hex_data(data.substr(data.find(L':') + 1));
+			return ValueType::Other;
+		}
+
+		hex_data(data.substr(7));
+
+		m_string.clear();
+		for (std::size_t i = 0; i + 1 < m_bytes.size(); i += 2)
+			m_string.push_back(static_cast<wchar_t>(m_bytes[i] | (m_bytes[i + 1] << 8)));
+
+		// Trim trailing nulls, as the registry read does
+		while (!m_string.empty() && m_string.back() == L'\0')
+			m_string.pop_back();
+		return ValueType::String;
+	}
+
+	// Comma-separated hex bytes into m_bytes; a trailing '\' continues on the next line
+	void SnapshotParser::hex_data(std::wstring_view data)
+	{
+		m_bytes.clear();
+		while (true)
+		{
+			data = trim(data);
+			const bool more = (!data.empty() && data.back() == L'\\');
+			if (more)
+				data.remove_suffix(1);
+
+			int value = -1;
+			for (const wchar_t c : data)
+			{
+				const int digit = hex_value(c);
+				if (digit >= 0)
+				{
+					value = (value < 0) ? digit : ((value << 4) | digit) & 0xFF;
+				}
+				else if (c == L',')
+				{
+					if (value >= 0)
+						m_bytes.push_back(static_cast<unsigned char>(value));
+					value = -1;
+				}
+			}
+			if (value >= 0)
+				m_bytes.push_back(static_cast<unsigned char>(value));
+
+			if (!more || !next_line(data))
+				break;
+		}
+	}
+
+	std::wstring_view SnapshotParser::unquote(std::wstring_view s, std::wstring& out)
+	{
+		out.clear();
+
+		std::size_t start = 0;
+		std::size_t i = 0;
+		for (; i < s.size() && s[i] != L'"'; ++i)
+		{
+			if (s[i] == L'\\' && i + 1 < s.size())
+			{
+				out.append(s.data() + start, i - start);
+				start = ++i;		// keep the escaped character
+			}
+		}
+		out.append(s.data() + start, i - start);
+
+		return (i < s.size()) ? s.substr(i + 1) : std::wstring_view();
+	}
+
+	// Read and parse one snapshot; text is a reusable decode buffer
+	bool read_snapshot(	const std::wstring& path,
+						std::vector<EthDriver>& drivers_out,
+						std::wstring& error_message,
+						std::wstring& text)
+	{
+		error_message.clear();
+		drivers_out.clear();
+
+		MappedFile file;
+		if (file.Open(path) != ERROR_SUCCESS)
+		{
+			error_message = L"Failed to open file: " + path;
+			return false;
+		}
+
+		decode_file(file.View(), text);
+		file.Close();
+
+		SnapshotParser parser(text);
+		if (!parser.parse(drivers_out))
+		{
+			error_message = L"Not a registry export file: " + path;
+			return false;
+		}
+		return true;
+	}
+}	// anonymous namespace
+
+
+namespace RegFile
+{
+	Writer::Writer(std::size_t buffer_size)
+		: m_buffer(std::max<std::size_t>(buffer_size, 256), '\0')
+	{}
+
+	bool Writer::open(const std::wstring& path, std::wstring& error_message)
+	{
+		error_message.clear();
+		if (m_file.is_open())
+			m_file.close();
+
+		m_path = path;
+		m_used = 0;
+		m_count = 0;
+		m_failed = false;
+
+		// Blocks are already large; skip the stream's own buffering
+		m_file.rdbuf()->pubsetbuf(nullptr, 0);
+		m_file.open(std::filesystem::path(path), std::ios::binary | std::ios::trunc);
+		if (!m_file.is_open())
+		{
+			error_message = L"Failed to open file for writing: " + path;
+			return false;
+		}
+
+		// UTF-16LE byte order mark, then the format line regedit expects
+		m_buffer[m_used++] = static_cast<char>(0xFF);
+		m_buffer[m_used++] = static_cast<char>(0xFE);
+		text(FILE_HEADER);
+		return true;
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: write
+
+		Desc: Appends one driver in the SaveDriver layout:
+
+			  [HKEY_LOCAL_MACHINE\...\AB_ETH\AB_ETH-1]
+			  "Name"="..."
+			  "Station"=dword:0000003f
+			  ...
+			  [-HKEY_LOCAL_MACHINE\...\AB_ETH\AB_ETH-1\Node Table]
+			  [HKEY_LOCAL_MACHINE\...\AB_ETH\AB_ETH-1\Node Table]
+			  "0"="10.0.0.1"
+		-----------------------------------------------------------------
+	*/
+	bool Writer::write(const EthDriver& driver)
+	{
+		if (driver.key_name.empty())
+			return false;
+
+		text(L"[");
+		key_path(driver.key_name, {});
+		text(L"]\r\n");
+
+		text(L"\"");
+		text(RegistryLayout::VAL_NAME);
+		text(L"\"=");
+		quoted(driver.name);
+		text(LINE_END);
+
+		dword(RegistryLayout::VAL_STATION, driver.station);
+		dword(RegistryLayout::VAL_PING_TIMEOUT, driver.ping_timeout);
+		dword(RegistryLayout::VAL_INACTIVITY, driver.inactivity_timeout);
+		dword(RegistryLayout::VAL_STARTUP, driver.startup);
+		text(LINE_END);
+
+		// Delete any existing Node Table first, as SaveDriver does
+		text(L"[-");
+		key_path(driver.key_name, RegistryLayout::SUBKEY_NODE_TABLE);
+		text(L"]\r\n\r\n");
+
+		text(L"[");
+		key_path(driver.key_name, RegistryLayout::SUBKEY_NODE_TABLE);
+		text(L"]\r\n");
+
+		// Text entries go back between the addresses where they were read, as in SaveDriver
+		std::size_t i = 0;
+		auto node = [&](std::wstring_view value)
+			{
+				// "12"="10.0.0.1"
+				wchar_t digits[12];
+				wchar_t* end = digits + 12;
+				wchar_t* first = end;
+				unsigned slot = RegistryLayout::node_slot(i++);
+				do
+				{
+					*--first = static_cast<wchar_t>(L'0' + slot % 10);
+					slot /= 10;
+				} while (slot != 0);
+
+				text(L"\"");
+				text(std::wstring_view(first, static_cast<std::size_t>(end - first)));
+				text(L"\"=");
+				quoted(value);
+				text(LINE_END);
+			};
+		for_each_node(driver,
+			[&](std::uint32_t address)
+			{
+				wchar_t formatted[16];
+				node(std::wstring_view(formatted, IPv4::format(address, formatted)));
+			},
+			node);
+		text(LINE_END);
+
+		++m_count;
+		return true;
+	}
+
+	void Writer::write(const std::vector<EthDriver>& drivers)
+	{
+		for (const EthDriver& driver : drivers)
+			write(driver);
+	}
+
+	bool Writer::close(std::wstring& error_message)
+	{
+		error_message.clear();
+
+		flush();
+		m_file.close();
+		if (m_file.fail())
+			m_failed = true;
+
+		if (m_failed)
+		{
+			error_message = L"Error occurred while writing to file: " + m_path;
+			return false;
+		}
+		return true;
+	}
+
+	// Wide text as UTF-16LE (wchar_t is UTF-16 on Windows, UTF-32 elsewhere)
+	void Writer::text(std::wstring_view text)
+	{
+		reserve(text.size() * 4);
+		char* out = &m_buffer[m_used];
+
+		for (const wchar_t c : text)
+		{
+			std::uint32_t unit = static_cast<std::uint32_t>(c);
+			if (unit > 0xFFFF)
+			{
+				unit -= 0x10000;
+				const std::uint32_t high = 0xD800 + (unit >> 10);
+				*out++ = static_cast<char>(high & 0xFF);
+				*out++ = static_cast<char>(high >> 8);
+				unit = 0xDC00 + (unit & 0x3FF);
+			}
+			*out++ = static_cast<char>(unit & 0xFF);
+			*out++ = static_cast<char>(unit >> 8);
+		}
+
+		m_used = static_cast<std::size_t>(out - m_buffer.data());
+	}
+
+	// "text" with \ and " escaped
+	void Writer::quoted(std::wstring_view value)
+	{
+		text(L"\"");
+
+		std::size_t start = 0;
+		for (std::size_t i = 0; i < value.size(); ++i)
+		{
+			if (value[i] != L'\\' && value[i] != L'"')
+				continue;
+
+			text(value.substr(start, i - start));
+			text(L"\\");
+			start = i;		// the character itself goes out with the next run
+		}
+		text(value.substr(start));
+
+		text(L"\"");
+	}
+
+	// "Name"=dword:0000003f
+	void Writer::dword(const wchar_t* name, DWORD value)
+	{
+		text(L"\"");
+		text(name);
+		text(L"\"=dword:");
+
+		wchar_t digits[8];
+		for (int i = 7; i >= 0; --i)
+		{
+			digits[i] = static_cast<wchar_t>(HEX_DIGITS[value & 0xF]);
+			value >>= 4;
+		}
+		text(std::wstring_view(digits, 8));
+		text(LINE_END);
+	}
+
+	// HKEY_LOCAL_MACHINE\SOFTWARE\...\AB_ETH\<key_name>[\<subkey>]
+	void Writer::key_path(std::wstring_view key_name, std::wstring_view subkey)
+	{
+		text(RegistryLayout::ROOT_NAME);
+		text(L"\\");
+		text(RegistryLayout::AB_ETH_BASE);
+		text(L"\\");
+		text(key_name);
+		if (!subkey.empty())
+		{
+			text(L"\\");
+			text(subkey);
+		}
+	}
+
+	void Writer::flush()
+	{
+		if (m_used == 0 || !m_file.is_open())
+			return;
+
+		m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+		m_used = 0;
+		if (!m_file)
+			m_failed = true;
+	}
+
+	void Writer::make_room(std::size_t n)
+	{
+		flush();
+		if (m_buffer.size() - m_used < n)
+			m_buffer.resize(m_used + n);
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: write_drivers_to_file
+
+		Desc: Writes a whole driver list to one .reg file.
+		-----------------------------------------------------------------
+	*/
+	bool write_drivers_to_file(		const std::wstring& path,
+									const std::vector<EthDriver>& drivers_in,
+									std::wstring& error_message)
+	{
+		Writer writer;
+		if (!writer.open(path, error_message))
+			return false;
+
+		writer.write(drivers_in);
+		return writer.close(error_message);
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: write_import_result_to_file
+
+		Desc: Writes the drivers an import would save to the registry,
+			  in the order the merge/overwrite handlers save them.
+		-----------------------------------------------------------------
+	*/
+	bool write_import_result_to_file(	const std::wstring& path,
+										const ImportEngine::ImportResult& result,
+										std::wstring& error_message)
+	{
+		Writer writer;
+		if (!writer.open(path, error_message))
+			return false;
+
+		writer.write(result.updated_drivers);
+		writer.write(result.new_drivers);
+		return writer.close(error_message);
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: write_host_files
+
+		Desc: Writes one .reg file per host. Each worker keeps its own
+			  Writer (and so its own buffer) and takes the next file
+			  until none are left.
+		-----------------------------------------------------------------
+	*/
+	bool write_host_files(			const std::vector<HostFile>& files,
+									std::vector<std::wstring>& errors,
+									unsigned threads)
+	{
+		errors.clear();
+		if (files.empty())
+			return true;
+
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		threads = static_cast<unsigned>(std::min<std::size_t>(threads, files.size()));
+
+		std::vector<std::wstring> file_errors(files.size());
+		std::atomic<std::size_t> next{ 0 };
+
+		auto work = [&]()
+			{
+				Writer writer;
+				for (std::size_t i = next++; i < files.size(); i = next++)
+				{
+					const HostFile& file = files[i];
+					if (!writer.open(file.path, file_errors[i]))
+						continue;
+
+					if (file.drivers != nullptr)
+						writer.write(*file.drivers);
+					writer.close(file_errors[i]);
+				}
+			};
+
+		std::vector<std::thread> pool;
+		for (unsigned t = 1; t < threads; ++t)
+			pool.emplace_back(work);
+		work();
+		for (std::thread& worker : pool)
+			worker.join();
+
+		// Report failures in file order, whatever order the workers hit them
+		for (std::wstring& error : file_errors)
+		{
+			if (!error.empty())
+				errors.push_back(std::move(error));
+		}
+		return errors.empty();
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: read_drivers_from_file
+
+		Desc: Parses one .reg export into the drivers LoadDrivers would
+			  have read from that machine's registry.
+		-----------------------------------------------------------------
+	*/
+	bool read_drivers_from_file(	const std::wstring& path,
+									std::vector<EthDriver>& drivers_out,
+									std::wstring& error_message)
+	{
+		std::wstring text;
+		return read_snapshot(path, drivers_out, error_message, text);
+	}
+
+	/*	-----------------------------------------------------------------
+		Function: read_snapshots
+
+		Desc: Parses many snapshots. Each worker takes the next file
+			  until none are left, reusing one decode buffer, so
+			  results do not depend on timing.
+		-----------------------------------------------------------------
+	*/
+	std::vector<Snapshot> read_snapshots(	const std::vector<std::wstring>& paths,
+											unsigned threads)
+	{
+		std::vector<Snapshot> snapshots(paths.size());
+		if (paths.empty())
+			return snapshots;
+
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		threads = static_cast<unsigned>(std::min<std::size_t>(threads, paths.size()));
+
+		std::atomic<std::size_t> next{ 0 };
+
+		auto work = [&]()
+			{
+				std::wstring text;
+				for (std::size_t i = next++; i < paths.size(); i = next++)
+				{
+					Snapshot& snapshot = snapshots[i];
+					snapshot.path = paths[i];
+					snapshot.success = read_snapshot(paths[i], snapshot.drivers, snapshot.error, text);
+				}
+			};
+
+		std::vector<std::thread> pool;
+		for (unsigned t = 1; t < threads; ++t)
+			pool.emplace_back(work);
+		work();
+		for (std::thread& worker : pool)
+			worker.join();
+
+		return snapshots;
+	}
+
+} // namespace RegFile
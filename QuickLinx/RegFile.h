@@ -0,0 +1,126 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <cstddef>
+#include <cstdint>
+
+#include "EthDriver.h"
+#include "ImportEngine.h"
+
+/*
+	File: RegFile.h
+
+	Description:
+		Writes AB_ETH drivers as a Windows .reg file (regedit format 5.00,
+		UTF-16LE), so a driver set can be pushed to many workstations with
+		"reg import" instead of running QuickLinx on each one.
+
+		Every driver is written exactly as RegistryManager::SaveDriver
+		stores it (see RegistryLayout.h): the five driver values, then the
+		Node Table is deleted and rewritten, so no stale nodes survive.
+
+		Output is assembled in one reusable buffer and written in large
+		blocks; a Writer can be reused for any number of files.
+
+		Also reads .reg exports of the AB_ETH subtree back into the same
+		driver list RegistryManager::LoadDrivers would return, so
+		snapshots collected from a whole plant can be analysed offline.
+		The reader needs no Windows API and parses many files at once.
+*/
+
+namespace RegFile
+{
+	//Write drivers to a .reg file one at a time: open(), write() each driver, close()
+	class Writer
+	{
+	public:
+		static constexpr std::size_t DEFAULT_BUFFER_SIZE = std::size_t(1) << 20;	// 1 MB
+
+		explicit Writer(std::size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+		Writer(const Writer&) = delete;
+		Writer& operator=(const Writer&) = delete;
+
+		bool open(const std::wstring& path, std::wstring& error_message);
+
+		// Returns false (and writes nothing) for a driver without a key name,
+		// which SaveDriver would refuse too
+		bool write(const EthDriver& driver);
+		void write(const std::vector<EthDriver>& drivers);
+
+		bool close(std::wstring& error_message);
+
+		std::size_t count() const noexcept { return m_count; }
+
+	private:
+		void text(std::wstring_view text);
+		void quoted(std::wstring_view text);
+		void dword(const wchar_t* name, DWORD value);
+		void key_path(std::wstring_view key_name, std::wstring_view subkey);
+		void flush();
+
+		void reserve(std::size_t n)
+		{
+			if (m_buffer.size() - m_used < n)
+				make_room(n);
+		}
+
+		void make_room(std::size_t n);
+
+		std::string		m_buffer;			// UTF-16LE bytes
+		std::size_t		m_used = 0;
+		std::ofstream	m_file;
+		std::wstring	m_path;
+		std::size_t		m_count = 0;
+		bool			m_failed = false;
+	};
+
+	//Write drivers to a .reg file (drivers without a key name are skipped)
+	bool write_drivers_to_file(		const std::wstring& path,
+									const std::vector<EthDriver>& drivers_in,
+									std::wstring& error_message);
+
+	//Write what merge_drivers/overwrite_drivers would save: updated, then new drivers
+	bool write_import_result_to_file(	const std::wstring& path,
+										const ImportEngine::ImportResult& result,
+										std::wstring& error_message);
+
+	//One output file of a plant-wide run
+	struct HostFile
+	{
+		std::wstring					path;			// e.g. "HMI-07.reg"
+		const std::vector<EthDriver>*	drivers;		// Not owned; several hosts may share one set
+	};
+
+	//Write many .reg files concurrently. Returns false if any failed; errors
+	//gets one message per failed file. threads = 0 uses every core.
+	bool write_host_files(			const std::vector<HostFile>& files,
+									std::vector<std::wstring>& errors,
+									unsigned threads = 0);
+
+	//Parse a .reg export (regedit 5.00 or REGEDIT4) of the AB_ETH subtree.
+	//Drivers come out in file order, and keys LoadDrivers would skip (no Name
+	//or Station) are skipped; keys outside the subtree are ignored.
+	bool read_drivers_from_file(	const std::wstring& path,
+									std::vector<EthDriver>& drivers_out,
+									std::wstring& error_message);
+
+	//One parsed snapshot file
+	struct Snapshot
+	{
+		std::wstring				path;
+		std::vector<EthDriver>		drivers;
+		std::wstring				error;					// Set when success is false
+
+		bool						success = true;			// Success flag
+	};
+
+	//Parse many .reg snapshots concurrently (one file per thread at a time).
+	//Returns one Snapshot per path, in path order. threads = 0 uses every core.
+	std::vector<Snapshot> read_snapshots(	const std::vector<std::wstring>& paths,
+											unsigned threads = 0);
+
+} // namespace RegFile
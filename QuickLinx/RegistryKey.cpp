@@ -82,7 +82,8 @@ void RegistryKey::Close() noexcept
 // Enumerate subkeys by index
 //------------------------------------------------------
 LONG RegistryKey::EnumSubkey(	DWORD index,
-								std::wstring& name_out) const noexcept
+								std::wstring& name_out,
+								FILETIME* last_write_out) const noexcept
 {
 	name_out.clear();
 
@@ -123,6 +124,9 @@ LONG RegistryKey::EnumSubkey(	DWORD index,
 	{
 		// name_len does not include terminating null
 		name_out.assign(buffer.data(), name_len);
+
+		if (last_write_out != nullptr)
+			*last_write_out = ft;
 	}
 
 	return result;
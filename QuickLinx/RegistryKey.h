@@ -63,9 +63,10 @@ public:
 
 	//-----------------Enumeration-------------------
 
-	// Enumerate subkey names
+	// Enumerate subkey names (and optionally each subkey's last-write time)
 	LONG EnumSubkey(	DWORD index, 
-						std::wstring& name_out) const noexcept;
+						std::wstring& name_out,
+						FILETIME* last_write_out = nullptr) const noexcept;
 
 	// Enumerate value entries (name, type, raw data)
 	LONG EnumValue(		DWORD index, 
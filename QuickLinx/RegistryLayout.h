@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+
+/*
+	File: RegistryLayout.h
+
+	Description:
+		Where and how RSLinx keeps AB_ETH drivers in the registry:
+
+		HKLM\SOFTWARE\WOW6432Node\Rockwell Software\RSLinx\Drivers\AB_ETH\AB_ETH-x
+			Name, Station, Ping Timeout, Inactivity Timeout, Startup
+			Node Table\0, 1, ... 62, 64, ...	(slot 63 is never used)
+
+		Shared by RegistryManager (live registry) and RegFile (.reg files)
+		so both read and write exactly the same layout.
+*/
+
+namespace RegistryLayout
+{
+	// Driver keys under HKEY_LOCAL_MACHINE (32-bit RSLinx on 64-bit Windows)
+	inline constexpr wchar_t AB_ETH_BASE[] =
+		L"SOFTWARE\\WOW6432Node\\Rockwell Software\\RSLinx\\Drivers\\AB_ETH";
+
+	// The same keys as a 32-bit Windows install (or a 32-bit regedit) names them
+	inline constexpr wchar_t AB_ETH_BASE_NATIVE[] =
+		L"SOFTWARE\\Rockwell Software\\RSLinx\\Drivers\\AB_ETH";
+
+	// Root key as it is spelled in .reg files
+	inline constexpr wchar_t ROOT_NAME[] = L"HKEY_LOCAL_MACHINE";
+
+	inline constexpr wchar_t VAL_NAME[] = L"Name";
+	inline constexpr wchar_t VAL_STATION[] = L"Station";
+	inline constexpr wchar_t VAL_PING_TIMEOUT[] = L"Ping Timeout";
+	inline constexpr wchar_t VAL_INACTIVITY[] = L"Inactivity Timeout";
+	inline constexpr wchar_t VAL_STARTUP[] = L"Startup";
+
+	inline constexpr wchar_t SUBKEY_NODE_TABLE[] = L"Node Table";
+
+	// Node Table value number RSLinx skips
+	constexpr unsigned SKIPPED_NODE_SLOT = 63;
+
+	// Node Table value number of the index-th node: 0, 1, ... 62, 64, ...
+	constexpr unsigned node_slot(std::size_t index) noexcept
+	{
+		return static_cast<unsigned>(index < SKIPPED_NODE_SLOT ? index : index + 1);
+	}
+
+}	// namespace RegistryLayout
@@ -1,22 +1,24 @@
 #include "RegistryManager.h"
 #include "RegistryKey.h"
+#include "RegistryLayout.h"
+#include "IPv4.h"
 
 #include <windows.h>
 #include <string>
+#include <algorithm>
 
 // Base registry path for AB_ETH drivers (32-bit RSLinx on 64-bit Windows)
 namespace
 {
-	const wchar_t* RSLINX_AB_ETH_BASE =
-		L"SOFTWARE\\WOW6432Node\\Rockwell Software\\RSLinx\\Drivers\\AB_ETH";
+	const wchar_t* RSLINX_AB_ETH_BASE = RegistryLayout::AB_ETH_BASE;
 
-	const wchar_t* VAL_NAME_NAME = L"Name";
-	const wchar_t* VAL_NAME_STATION = L"Station";
-	const wchar_t* VAL_NAME_PING_TIMEOUT = L"Ping Timeout";
-	const wchar_t* VAL_NAME_INACTIVITY = L"Inactivity Timeout";
-	const wchar_t* VAL_NAME_STARTUP = L"Startup";
+	const wchar_t* VAL_NAME_NAME = RegistryLayout::VAL_NAME;
+	const wchar_t* VAL_NAME_STATION = RegistryLayout::VAL_STATION;
+	const wchar_t* VAL_NAME_PING_TIMEOUT = RegistryLayout::VAL_PING_TIMEOUT;
+	const wchar_t* VAL_NAME_INACTIVITY = RegistryLayout::VAL_INACTIVITY;
+	const wchar_t* VAL_NAME_STARTUP = RegistryLayout::VAL_STARTUP;
 
-	const wchar_t* SUBKEY_NODE_TABLE = L"Node Table";
+	const wchar_t* SUBKEY_NODE_TABLE = RegistryLayout::SUBKEY_NODE_TABLE;
 
 	// Small helper to join base path + subkey
 	std::wstring JoinPath(const std::wstring& base, const std::wstring& sub)
@@ -45,61 +47,46 @@ namespace
 
 		return std::wstring(wptr, len);
 	}
-}	// namespace
-
 
-//	---------------------------------------------------------------------
-//	Load all AB_ETH-x drivers from Registry
-//	---------------------------------------------------------------------
-std::vector<EthDriver> RegistryManager::LoadDrivers()
-{
-	std::vector<EthDriver> drivers;
-
-	RegistryKey baseKey;
-	LONG result = baseKey.Open(HKEY_LOCAL_MACHINE, RSLINX_AB_ETH_BASE);
-	if (result != ERROR_SUCCESS)
+	ULONGLONG FileTimeToCount(const FILETIME& ft)
 	{
-		// Could not open base key  return empty list.
-		return drivers;
+		return (static_cast<ULONGLONG>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
 	}
 
-	DWORD index = 0;
-	std::wstring subKeyName;
-
-	while (true)
+	// Read one driver key (values and Node Table) into driver.
+	// Returns false if the key cannot be opened, lacks Name/Station,
+	// or does not match filter (if given).
+	bool ReadDriver(const std::wstring& subKeyName, EthDriver& driver, const DriverFilter* filter = nullptr)
 	{
-		subKeyName.clear();
-		result = baseKey.EnumSubkey(index, subKeyName);
-
-		if (result == ERROR_NO_MORE_ITEMS)
-		{
-			break;	// finished enumeration
-		}
-		else if (result != ERROR_SUCCESS)
-		{
-			// Some other error  stop enumerating
-			break;
-		}
-
-		++index;
-
 		// Open this specific driver key, e.g. AB_ETH-1
 		const std::wstring fullPath = JoinPath(RSLINX_AB_ETH_BASE, subKeyName);
 		RegistryKey driverKey;
 		if (driverKey.Open(HKEY_LOCAL_MACHINE, fullPath) != ERROR_SUCCESS)
 		{
 			// Skip this driver if it cannot be opened
-			continue;
+			return false;
 		}
 
-		EthDriver driver;
-		driver.key_name = subKeyName;	// "AB_ETH-1"
-
-		// Read basic values; if any required one fails, skip this driver
-		if (driverKey.QueryString(VAL_NAME_NAME, driver.name) != ERROR_SUCCESS)
-			continue;
+		driver.key_name.assign(subKeyName);	// "AB_ETH-1"
+		driver.name.clear();
+		driver.ping_timeout = 0;
+		driver.inactivity_timeout = 0;
+		driver.startup = 0;
+		driver.nodes.clear();
+		driver.extra_nodes.clear();
+
+		// Read basic values; if any required one fails, skip this driver.
+		// A Name over the RSLinx limit is still kept, so its key stays in use.
+		std::wstring name;
+		if (driverKey.QueryString(VAL_NAME_NAME, name) != ERROR_SUCCESS)
+			return false;
+		driver.name.assign(name);
+
+		// Name filter - reject before any more of the key is read
+		if (filter != nullptr && !filter->matches_name(driver.name))
+			return false;
 		if (driverKey.QueryDword(VAL_NAME_STATION, driver.station) != ERROR_SUCCESS)
-			continue;
+			return false;
 
 		// Optional values  ignore errors
 		(void)driverKey.QueryDword(VAL_NAME_PING_TIMEOUT, driver.ping_timeout);
@@ -145,18 +132,174 @@ std::vector<EthDriver> RegistryManager::LoadDrivers()
 				std::wstring ip = BytesToWString(data);
 				if (!ip.empty())
 				{
-					driver.nodes.push_back(ip);
+					// Addresses are kept packed; anything else (or past the
+					// node limit) is kept as text so it survives a save
+					std::uint32_t address = 0;
+					if (IPv4::parse_address(std::wstring_view(ip), address) != IPv4::ParseError::None ||
+						!driver.nodes.push_back(address))
+					{
+						const std::uint32_t before = static_cast<std::uint32_t>(driver.nodes.size());
+						driver.extra_nodes.push_back({ before, std::move(ip) });
+					}
 				}
 			}
 		}
 
-		drivers.push_back(std::move(driver));
+		if (filter != nullptr && !filter->matches_nodes(driver.nodes))
+			return false;
+
+		return true;
 	}
+}	// namespace
+
+
+//	---------------------------------------------------------------------
+//	Load all AB_ETH-x drivers from Registry
+//	---------------------------------------------------------------------
+std::vector<EthDriver> RegistryManager::LoadDrivers(const DriverFilter& filter)
+{
+	std::vector<EthDriver> drivers;
+
+	EnumerateDrivers([&drivers](EthDriver& driver)
+		{
+			drivers.push_back(std::move(driver));
+			return true;
+		}, filter);
 
 	return drivers;
 }
 
 
+//	---------------------------------------------------------------------
+//	Load all AB_ETH-x drivers from Registry into a DriverTable
+//	---------------------------------------------------------------------
+void RegistryManager::LoadDrivers(DriverTable& drivers_out, const DriverFilter& filter)
+{
+	EnumerateDrivers([&drivers_out](EthDriver& driver)
+		{
+			drivers_out.append(driver);
+			return true;
+		}, filter);
+}
+
+
+//	---------------------------------------------------------------------
+//	Read AB_ETH-x drivers one at a time, in enumeration order
+//	---------------------------------------------------------------------
+std::size_t RegistryManager::EnumerateDrivers(	const std::function<bool(EthDriver& driver)>& onDriver,
+												const DriverFilter& filter)
+{
+	std::size_t count = 0;
+
+	RegistryKey baseKey;
+	LONG result = baseKey.Open(HKEY_LOCAL_MACHINE, RSLINX_AB_ETH_BASE);
+	if (result != ERROR_SUCCESS)
+	{
+		// Could not open base key  nothing to enumerate.
+		return count;
+	}
+
+	// One driver is reused for every key, so memory does not grow with
+	// the number of drivers (unless onDriver keeps them)
+	EthDriver driver;
+
+	DWORD index = 0;
+	std::wstring subKeyName;
+
+	while (true)
+	{
+		subKeyName.clear();
+		result = baseKey.EnumSubkey(index, subKeyName);
+
+		if (result == ERROR_NO_MORE_ITEMS)
+		{
+			break;	// finished enumeration
+		}
+		else if (result != ERROR_SUCCESS)
+		{
+			// Some other error  stop enumerating
+			break;
+		}
+
+		++index;
+
+		if (!ReadDriver(subKeyName, driver, filter.is_empty() ? nullptr : &filter))
+			continue;
+
+		++count;
+		if (!onDriver(driver))
+			break;
+	}
+
+	return count;
+}
+
+
+//	---------------------------------------------------------------------
+//	Enumerate AB_ETH-x key names with their last-write stamp
+//	---------------------------------------------------------------------
+std::size_t RegistryManager::EnumerateDriverKeys(const std::function<bool(const std::wstring& keyName, ULONGLONG lastWrite)>& onKey)
+{
+	std::size_t count = 0;
+
+	RegistryKey baseKey;
+	LONG result = baseKey.Open(HKEY_LOCAL_MACHINE, RSLINX_AB_ETH_BASE);
+	if (result != ERROR_SUCCESS)
+		return count;
+
+	DWORD index = 0;
+	std::wstring subKeyName;
+	std::wstring childName;
+
+	while (true)
+	{
+		FILETIME keyTime = {};
+		result = baseKey.EnumSubkey(index, subKeyName, &keyTime);
+		if (result != ERROR_SUCCESS)
+			break;	// ERROR_NO_MORE_ITEMS or an error  stop either way
+
+		++index;
+
+		ULONGLONG lastWrite = FileTimeToCount(keyTime);
+
+		// Node values live one level down; editing them only touches the
+		// Node Table key, so take its time too (read from the driver key's
+		// subkey list, without opening the Node Table itself)
+		RegistryKey driverKey;
+		if (driverKey.Open(HKEY_LOCAL_MACHINE, JoinPath(RSLINX_AB_ETH_BASE, subKeyName)) == ERROR_SUCCESS)
+		{
+			FILETIME childTime = {};
+			for (DWORD child = 0; driverKey.EnumSubkey(child, childName, &childTime) == ERROR_SUCCESS; ++child)
+			{
+				if (childName == SUBKEY_NODE_TABLE)
+				{
+					lastWrite = (std::max)(lastWrite, FileTimeToCount(childTime));
+					break;
+				}
+			}
+		}
+
+		++count;
+		if (!onKey(subKeyName, lastWrite))
+			break;
+	}
+
+	return count;
+}
+
+
+//	---------------------------------------------------------------------
+//	Load one driver by key name
+//	---------------------------------------------------------------------
+bool RegistryManager::LoadDriver(const std::wstring& keyName, EthDriver& driver)
+{
+	if (keyName.empty())
+		return false;
+
+	return ReadDriver(keyName, driver);
+}
+
+
 //	---------------------------------------------------------------------
 //	Save (create or overwrite_drivers) one driver
 //	---------------------------------------------------------------------
@@ -165,7 +308,7 @@ bool RegistryManager::SaveDriver(const EthDriver& driver)
 	if (driver.key_name.empty())
 		return false;
 
-	const std::wstring fullPath = JoinPath(RSLINX_AB_ETH_BASE, driver.key_name);
+	const std::wstring fullPath = JoinPath(RSLINX_AB_ETH_BASE, driver.key_name.str());
 
 	RegistryKey driverKey;
 	LONG result = driverKey.Create(
@@ -179,7 +322,7 @@ bool RegistryManager::SaveDriver(const EthDriver& driver)
 
 	bool ok = true;
 
-	ok = ok && (driverKey.SetString(VAL_NAME_NAME, driver.name) == ERROR_SUCCESS);
+	ok = ok && (driverKey.SetString(VAL_NAME_NAME, driver.name.str()) == ERROR_SUCCESS);
 	ok = ok && (driverKey.SetDword(VAL_NAME_STATION, driver.station) == ERROR_SUCCESS);
 	ok = ok && (driverKey.SetDword(VAL_NAME_PING_TIMEOUT, driver.ping_timeout) == ERROR_SUCCESS);
 	ok = ok && (driverKey.SetDword(VAL_NAME_INACTIVITY, driver.inactivity_timeout) == ERROR_SUCCESS);
@@ -205,24 +348,17 @@ bool RegistryManager::SaveDriver(const EthDriver& driver)
 	if (result != ERROR_SUCCESS)
 		return false;
 
-	int node_num = 0;
-
 	// Write each node as a sequential value: "0", "1", "2", ... skipping 63
-	for (size_t i = 0; i < driver.nodes.size(); ++i)
-	{
-		if (node_num == 63)
-			++node_num;
-
-		const std::wstring valueName = std::to_wstring(node_num);
-		const std::wstring& ip = driver.nodes[i];
-
-		if (nodeKey.SetString(valueName, ip) != ERROR_SUCCESS)
+	// (text entries go back between the addresses where they were read)
+	size_t i = 0;
+	auto writeNode = [&](const std::wstring& ip)
 		{
-			ok = false;
-			break;
-		}
-		++node_num;
-	}
+			if (ok && nodeKey.SetString(std::to_wstring(RegistryLayout::node_slot(i++)), ip) != ERROR_SUCCESS)
+				ok = false;
+		};
+	for_each_node(driver,
+		[&](std::uint32_t address) { writeNode(IPv4::to_wstring(address)); },
+		writeNode);
 
 	return ok;
 }
@@ -2,7 +2,10 @@
 
 #include <vector>
 #include <string>
+#include <functional>
 #include "EthDriver.h"
+#include "DriverFilter.h"
+#include "DriverTable.h"
 
 /*
 	File: RegistryManager.h
@@ -18,8 +21,28 @@ class RegistryManager {
 
 public:
 
-	//	Load all AB_ETH-x drivers from Registry
-	static std::vector<EthDriver> LoadDrivers();
+	//	Load all AB_ETH-x drivers from Registry (optionally only those matching filter)
+	static std::vector<EthDriver> LoadDrivers(const DriverFilter& filter = DriverFilter());
+
+	//	The same, appended straight to a DriverTable (e.g. for ImportEngine) without a vector in between
+	static void LoadDrivers(DriverTable& drivers_out, const DriverFilter& filter = DriverFilter());
+
+	//	Read AB_ETH-x drivers one at a time without collecting them. onDriver sees
+	//	each driver as soon as its key and Node Table are read (the same object is
+	//	reused, so move from it to keep it); return false to stop.
+	//	Drivers not matching filter are skipped; a name mismatch is detected before
+	//	the Node Table is opened. Returns the number of drivers passed to onDriver.
+	static std::size_t EnumerateDrivers(	const std::function<bool(EthDriver& driver)>& onDriver,
+											const DriverFilter& filter = DriverFilter());
+
+	//	Enumerate AB_ETH-x key names with a change stamp, without reading any values.
+	//	The stamp is the later of the key's and its Node Table's last-write time
+	//	(FILETIME as a 64-bit count), so any edit to the driver changes it.
+	//	Return false from onKey to stop. Returns the number of keys visited.
+	static std::size_t EnumerateDriverKeys(const std::function<bool(const std::wstring& keyName, ULONGLONG lastWrite)>& onKey);
+
+	//	Load one driver by key name, e.g. "AB_ETH-1" (Returns false if missing or incomplete)
+	static bool LoadDriver(const std::wstring& keyName, EthDriver& driver);
 
 	//	Save (create or overwrite_drivers) one driver (Returns true on success)
 	static bool SaveDriver(const EthDriver& driver);
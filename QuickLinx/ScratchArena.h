@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+/*
+	File: ScratchArena.h
+
+	Description:
+		Memory for the temporary containers of one operation (a CSV
+		read, an import): indexes, per-driver parse state, node sets and
+		the like.
+
+		Operations take an optional std::pmr::memory_resource. Given one,
+		they allocate their scratch from it; given nullptr, they use a
+		monotonic arena that lives for the call and is released in one go
+		when it returns, so thousands of small frees become one.
+
+		Results handed back to the caller (EthDriver lists, ImportResult)
+		never come from the scratch memory.
+
+		A monotonic arena is not thread-safe; code that fans out to worker
+		threads gives each thread its own.
+*/
+
+class ScratchArena {
+
+public:
+	static constexpr std::size_t FIRST_BLOCK = std::size_t(64) << 10;		// 64 KB, growing geometrically
+
+	// memory: the caller's resource, or nullptr for an arena owned by this object
+	explicit ScratchArena(std::pmr::memory_resource* memory)
+		: m_arena(FIRST_BLOCK)
+		, m_memory(memory != nullptr ? memory : &m_arena)
+	{}
+
+	ScratchArena(const ScratchArena&) = delete;
+	ScratchArena& operator=(const ScratchArena&) = delete;
+
+	std::pmr::memory_resource* resource() const noexcept { return m_memory; }
+
+private:
+	std::pmr::monotonic_buffer_resource		m_arena;			// Takes no memory until first used
+	std::pmr::memory_resource*				m_memory;
+
+};
@@ -0,0 +1,152 @@
+#include "Bench.h"
+#include "CSV.h"
+#include "ImportEngine.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#include <filesystem>
+#include <memory_resource>
+#include <new>
+
+/*
+	Bench: arena
+
+	Counts heap allocations (and times) a CSV read, a merge and an
+	overwrite, each run twice: with its default per-call scratch arena
+	(see ScratchArena.h) and with every scratch container allocating
+	straight from the heap (std::pmr::new_delete_resource).
+
+	Allocations are counted by replacing the global operator new for
+	this program, including the aligned forms the standard memory
+	resources may use.
+*/
+
+namespace
+{
+	std::atomic<std::size_t> g_allocations{ 0 };
+
+	void* counted_alloc(std::size_t size, std::size_t alignment)
+	{
+		g_allocations.fetch_add(1, std::memory_order_relaxed);
+		size = (size + alignment - 1) / alignment * alignment;
+		if (size == 0)
+			size = alignment;
+#ifdef _WIN32
+		void* p = _aligned_malloc(size, alignment);
+#else
+		void* p = std::aligned_alloc(alignment, size);
+#endif
+		if (p == nullptr)
+			throw std::bad_alloc();
+		return p;
+	}
+
+	void counted_free(void* p) noexcept
+	{
+#ifdef _WIN32
+		_aligned_free(p);
+#else
+		std::free(p);
+#endif
+	}
+}
+
+void* operator new(std::size_t size) { return counted_alloc(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](std::size_t size) { return counted_alloc(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return counted_alloc(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return counted_alloc(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+
+namespace
+{
+	struct Measure
+	{
+		std::size_t		allocations = 0;
+		double			ms = 0.0;
+	};
+
+	// Allocations made by one call to work, and its best time over a few more
+	template <typename Work>
+	Measure measure(Work&& work)
+	{
+		constexpr int RUNS = 3;
+
+		Measure m;
+		const std::size_t before = g_allocations.load();
+		work();
+		m.allocations = g_allocations.load() - before;
+		m.ms = Bench::best_ms(RUNS, work);
+		return m;
+	}
+
+	void report(const char* operation, const Measure& heap, const Measure& arena)
+	{
+		std::printf("  %-10s %14zu %10.2f %14zu %10.2f\n", operation, heap.allocations, heap.ms, arena.allocations, arena.ms);
+	}
+}
+
+namespace Bench
+{
+	void arena(std::size_t driver_count)
+	{
+		const std::vector<EthDriver> registry = make_drivers(driver_count, 1);
+		const std::vector<EthDriver> imported = make_drivers(driver_count, 2);
+
+		const std::wstring path = temp_path(L"QuickLinxBench-arena.csv");
+		std::wstring error;
+		if (!CSV::write_drivers_to_file(path, imported, error))
+		{
+			std::fprintf(stderr, "arena: %ls\n", error.c_str());
+			return;
+		}
+
+		std::printf("arena: %zu drivers\n", driver_count);
+		std::printf("  %-10s %14s %10s %14s %10s\n", "operation", "heap allocs", "heap ms", "arena allocs", "arena ms");
+
+		// Read, single-threaded so both runs do the same work on one thread
+		CSV::ReadOptions options;
+		options.threads = 1;
+		std::vector<EthDriver> drivers;
+
+		options.memory = std::pmr::new_delete_resource();
+		const Measure read_heap = measure([&] { drivers.clear(); CSV::read_drivers_from_file(path, drivers, error, options); });
+		options.memory = nullptr;
+		const Measure read_arena = measure([&] { drivers.clear(); CSV::read_drivers_from_file(path, drivers, error, options); });
+		report("read", read_heap, read_arena);
+
+		// Import, on columnar sets built up front so only the engine's own scratch is counted
+		const DriverTable registry_table(registry);
+		const DriverTable imported_table(imported);
+
+		const Measure merge_heap = measure([&] {
+			ImportEngine::merge_drivers(registry_table, imported_table, std::pmr::new_delete_resource());
+			});
+		const Measure merge_arena = measure([&] {
+			ImportEngine::merge_drivers(registry_table, imported_table);
+			});
+		report("merge", merge_heap, merge_arena);
+
+		const Measure overwrite_heap = measure([&] {
+			ImportEngine::overwrite_drivers(registry_table, imported_table, std::pmr::new_delete_resource());
+			});
+		const Measure overwrite_arena = measure([&] {
+			ImportEngine::overwrite_drivers(registry_table, imported_table);
+			});
+		report("overwrite", overwrite_heap, overwrite_arena);
+
+		std::error_code ec;
+		std::filesystem::remove(path, ec);
+	}
+}
@@ -0,0 +1,46 @@
+#include "Bench.h"
+
+#include <filesystem>
+#include <random>
+#include <string>
+
+namespace Bench
+{
+	std::vector<EthDriver> make_drivers(std::size_t count, unsigned seed)
+	{
+		std::mt19937 random(seed);
+		std::vector<EthDriver> drivers(count);
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			EthDriver& driver = drivers[i];
+			driver.key_name = DriverName(L"AB_ETH-" + std::to_wstring(i + 1));
+			driver.name = DriverName(L"BENCH-" + std::to_wstring(i));
+			driver.station = 63;
+			driver.ping_timeout = 3;
+			driver.inactivity_timeout = 30;
+			driver.startup = 0;
+
+			// Runs of consecutive hosts in a /24 of its own (10.x.y.0, then
+			// 11.x.y.0, ...), so every driver's nodes are distinct and
+			// export as a handful of ranges
+			const std::uint32_t subnet = static_cast<std::uint32_t>(((10 + (i >> 16)) << 24) | ((i & 0xFFFF) << 8));
+			const std::size_t runs = 1 + random() % 4;
+			std::uint32_t host = 1;
+			for (std::size_t run = 0; run < runs && host < 250; ++run)
+			{
+				const std::uint32_t length = 1 + random() % 10;
+				for (std::uint32_t n = 0; n < length && host < 255; ++n)
+					driver.nodes.push_back(subnet | host++);
+				host += 1 + random() % 4;
+			}
+		}
+
+		return drivers;
+	}
+
+	std::wstring temp_path(const wchar_t* name)
+	{
+		return (std::filesystem::temp_directory_path() / name).wstring();
+	}
+}
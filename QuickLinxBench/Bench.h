@@ -0,0 +1,53 @@
+#pragma once
+
+#include "EthDriver.h"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+	File: Bench.h
+
+	Description:
+		Shared pieces of the QuickLinxBench console program: a timer,
+		a generator for large, valid driver sets and a scratch file
+		location.
+
+		Each bench is a function taking the number of drivers to
+		generate; main() picks which ones run from the command line.
+*/
+
+namespace Bench
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Best (lowest) wall time of runs calls to work, in milliseconds
+	template <typename Work>
+	double best_ms(int runs, Work&& work)
+	{
+		double best = 0.0;
+		for (int run = 0; run < runs; ++run)
+		{
+			const Clock::time_point start = Clock::now();
+			work();
+			const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+			if (run == 0 || ms < best)
+				best = ms;
+		}
+		return best;
+	}
+
+	// count drivers named BENCH-0, BENCH-1, ... each with 1-40 nodes in a few
+	// runs. The same seed always gives the same drivers.
+	std::vector<EthDriver> make_drivers(std::size_t count, unsigned seed = 1);
+
+	// A file in the system temp directory (removed by the bench that uses it)
+	std::wstring temp_path(const wchar_t* name);
+
+	// Benches
+	void scan(std::size_t drivers);
+	void export_drivers(std::size_t drivers);
+	void arena(std::size_t drivers);
+}
@@ -0,0 +1,91 @@
+#include "Bench.h"
+#include "CSV.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+/*
+	Bench: export
+
+	Times write_drivers_to_file on a generated driver set with one
+	formatting thread, then with 2, 4, ... and the hardware thread
+	count, and checks each parallel export is byte for byte the serial
+	one.
+*/
+
+namespace
+{
+	std::uintmax_t file_size(const std::wstring& path)
+	{
+		std::error_code ec;
+		const std::uintmax_t size = std::filesystem::file_size(path, ec);
+		return ec ? 0 : size;
+	}
+
+	bool same_contents(const std::wstring& a, const std::wstring& b)
+	{
+		MappedFile fa;
+		MappedFile fb;
+		return fa.Open(a) == ERROR_SUCCESS && fb.Open(b) == ERROR_SUCCESS && fa.View() == fb.View();
+	}
+}
+
+namespace Bench
+{
+	void export_drivers(std::size_t driver_count)
+	{
+		constexpr int RUNS = 5;
+
+		const std::vector<EthDriver> drivers = make_drivers(driver_count);
+		const std::wstring serial_path = temp_path(L"QuickLinxBench-export-1.csv");
+		const std::wstring path = temp_path(L"QuickLinxBench-export.csv");
+
+		std::wstring error;
+		CSV::WriteOptions options;
+		options.threads = 1;
+		const double serial_ms = best_ms(RUNS, [&] {
+			CSV::write_drivers_to_file(serial_path, drivers, error, options);
+			});
+
+		if (!error.empty())
+		{
+			std::fprintf(stderr, "export: %ls\n", error.c_str());
+			return;
+		}
+
+		const double mb = static_cast<double>(file_size(serial_path)) / (1024.0 * 1024.0);
+		std::printf("export: %zu drivers, %.1f MB CSV, best of %d\n", driver_count, mb, RUNS);
+		std::printf("  %-8s %10s %14s %10s\n", "threads", "ms", "drivers/s", "speedup");
+		std::printf("  %-8u %10.2f %14.0f %10.2f\n", 1u, serial_ms, driver_count / (serial_ms / 1000.0), 1.0);
+
+		std::vector<unsigned> thread_counts;
+		const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+		for (unsigned threads = 2; threads < hardware; threads *= 2)
+			thread_counts.push_back(threads);
+		if (hardware > 1)
+			thread_counts.push_back(hardware);
+
+		for (unsigned threads : thread_counts)
+		{
+			options.threads = threads;
+			const double ms = best_ms(RUNS, [&] {
+				CSV::write_drivers_to_file(path, drivers, error, options);
+				});
+
+			if (!error.empty() || !same_contents(serial_path, path))
+			{
+				std::fprintf(stderr, "export: %u threads wrote a different file %ls\n", threads, error.c_str());
+				break;
+			}
+
+			std::printf("  %-8u %10.2f %14.0f %10.2f\n", threads, ms, driver_count / (ms / 1000.0), serial_ms / ms);
+		}
+
+		std::error_code ec;
+		std::filesystem::remove(serial_path, ec);
+		std::filesystem::remove(path, ec);
+	}
+}
@@ -0,0 +1,198 @@
+#include "Bench.h"
+#include "CSV.h"
+#include "CSVScan.h"
+#include "CSVTokenizer.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cwctype>
+#include <filesystem>
+#include <fstream>
+
+/*
+	Bench: scan
+
+	Writes a large CSV and splits every line of it into trimmed columns,
+	first the way the CSV reader did before the vector kernels (a
+	std::wifstream, std::getline, and split_csv_line pushing one wchar_t
+	at a time and trimming with iswspace), then with CSV::Tokenizer over
+	the mapped file at each Scan level (scalar, SSE2, AVX2). The speedup
+	column is against that original path.
+
+	Each level also times a whole single-threaded read_drivers_from_file.
+	Levels the CPU lacks are clamped by set_level and reported as such.
+*/
+
+namespace
+{
+	const char* level_name(CSV::Scan::Level level)
+	{
+		switch (level)
+		{
+		case CSV::Scan::Level::Scalar:	return "scalar";
+		case CSV::Scan::Level::SSE2:	return "SSE2";
+		case CSV::Scan::Level::AVX2:	return "AVX2";
+		}
+		return "?";
+	}
+
+	// ---- The reader's line splitting before CSVScan, kept verbatim for comparison ----
+
+	inline void trim_left(std::wstring& s)
+	{
+		s.erase(s.begin(),
+			std::find_if(s.begin(), s.end(),
+				[](wchar_t ch) { return !iswspace(ch); }));
+	}
+
+	inline void trim_right(std::wstring& s)
+	{
+		s.erase(std::find_if(s.rbegin(), s.rend(),
+			[](wchar_t ch) { return !iswspace(ch); }).base(),
+			s.end());
+	}
+
+	inline void trim(std::wstring& s)
+	{
+		trim_left(s);
+		trim_right(s);
+	}
+
+	std::vector<std::wstring> split_csv_line(const std::wstring& line)
+	{
+		std::vector<std::wstring> cols;
+		std::wstring current;
+
+		for (wchar_t ch : line)
+		{
+			if (ch == L',')
+			{
+				trim(current);
+				cols.push_back(current);
+				current.clear();
+			}
+			else
+			{
+				current.push_back(ch);
+			}
+		}
+
+		trim(current);
+		cols.push_back(current);
+		return cols;
+	}
+
+	// Columns in the file, split the original way (blank lines skipped, as the reader did)
+	std::size_t count_columns_baseline(const std::wstring& path)
+	{
+		std::wifstream file{ std::filesystem::path(path) };
+		std::wstring line;
+		std::size_t count = 0;
+
+		while (std::getline(file, line))
+		{
+			std::wstring tmp = line;
+			trim(tmp);
+			if (tmp.empty())
+				continue;
+
+			count += split_csv_line(line).size();
+		}
+
+		return count;
+	}
+
+	// ---- The same work on the current tokenizer ----
+
+	std::size_t count_columns(std::string_view data)
+	{
+		CSV::Tokenizer tokenizer(data);
+		std::string_view cols[3];
+		std::size_t count = 0;
+
+		for (std::size_t found; (found = tokenizer.next_row(cols, 3)) != 0; )
+		{
+			if (found == 1 && cols[0].empty())
+				continue;
+			count += found;
+		}
+
+		return count;
+	}
+}
+
+namespace Bench
+{
+	void scan(std::size_t driver_count)
+	{
+		constexpr int RUNS = 5;
+
+		const std::wstring path = temp_path(L"QuickLinxBench-scan.csv");
+		std::wstring error;
+		if (!CSV::write_drivers_to_file(path, make_drivers(driver_count), error))
+		{
+			std::fprintf(stderr, "scan: %ls\n", error.c_str());
+			return;
+		}
+
+		MappedFile file;
+		if (file.Open(path) != ERROR_SUCCESS)
+		{
+			std::fprintf(stderr, "scan: could not map %ls\n", path.c_str());
+			return;
+		}
+
+		const double mb = static_cast<double>(file.Size()) / (1024.0 * 1024.0);
+		std::printf("scan: %zu drivers, %.1f MB CSV, best of %d\n", driver_count, mb, RUNS);
+		std::printf("  %-9s %10s %10s %9s %10s %10s\n", "path", "split ms", "split MB/s", "speedup", "read ms", "read MB/s");
+
+		std::size_t baseline_columns = 0;
+		const double baseline_ms = best_ms(RUNS, [&] {
+			baseline_columns = count_columns_baseline(path);
+			});
+		std::printf("  %-9s %10.2f %10.0f %9s %10s %10s\n", "baseline",
+					baseline_ms, mb / (baseline_ms / 1000.0), "1.0x", "-", "-");
+
+		const CSV::Scan::Level detected = CSV::Scan::active_level();
+		CSV::ReadOptions options;
+		options.threads = 1;				// Measure the kernels, not the thread pool
+
+		for (CSV::Scan::Level level : { CSV::Scan::Level::Scalar, CSV::Scan::Level::SSE2, CSV::Scan::Level::AVX2 })
+		{
+			CSV::Scan::set_level(level);
+			if (CSV::Scan::active_level() != level)
+			{
+				std::printf("  %-9s (not supported by this CPU)\n", level_name(level));
+				continue;
+			}
+
+			std::size_t columns = 0;
+			const double split_ms = best_ms(RUNS, [&] {
+				columns = count_columns(file.View());
+				});
+
+			std::vector<EthDriver> drivers;
+			bool read = true;
+			const double read_ms = best_ms(RUNS, [&] {
+				drivers.clear();
+				read = CSV::read_drivers_from_file(path, drivers, error, options);
+				});
+
+			if (!read || drivers.size() != driver_count || columns != baseline_columns)
+			{
+				std::fprintf(stderr, "scan: read failed at %s: %ls\n", level_name(level), error.c_str());
+				break;
+			}
+
+			char speedup[16];
+			std::snprintf(speedup, sizeof(speedup), "%.1fx", baseline_ms / split_ms);
+			std::printf("  %-9s %10.2f %10.0f %9s %10.2f %10.0f\n", level_name(level),
+						split_ms, mb / (split_ms / 1000.0), speedup, read_ms, mb / (read_ms / 1000.0));
+		}
+
+		CSV::Scan::set_level(detected);
+		file.Close();
+		std::filesystem::remove(path);
+	}
+}
@@ -0,0 +1,56 @@
+#include "Bench.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/*
+	QuickLinxBench [bench] [drivers]
+
+	Runs one bench, or all of them when none is named, on a generated
+	driver set (default 100000 drivers). Build Release for meaningful
+	numbers.
+*/
+
+namespace
+{
+	struct Entry
+	{
+		const char*		name;
+		void			(*run)(std::size_t drivers);
+	};
+
+	const Entry BENCHES[] = {
+		{ "scan",		Bench::scan },
+		{ "export",		Bench::export_drivers },
+		{ "arena",		Bench::arena },
+	};
+}
+
+int main(int argc, char* argv[])
+{
+	const char* only = (argc > 1) ? argv[1] : nullptr;
+	std::size_t drivers = 100000;
+	if (argc > 2)
+		drivers = static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10));
+
+	bool ran = false;
+	for (const Entry& bench : BENCHES)
+	{
+		if (only != nullptr && std::strcmp(only, "all") != 0 && std::strcmp(only, bench.name) != 0)
+			continue;
+		bench.run(drivers);
+		ran = true;
+	}
+
+	if (!ran)
+	{
+		std::fprintf(stderr, "usage: QuickLinxBench [all");
+		for (const Entry& bench : BENCHES)
+			std::fprintf(stderr, "|%s", bench.name);
+		std::fprintf(stderr, "] [drivers]\n");
+		return 1;
+	}
+
+	return 0;
+}
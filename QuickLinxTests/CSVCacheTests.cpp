@@ -0,0 +1,61 @@
+#include "Test.h"
+#include "CSVCache.h"
+
+#include <filesystem>
+
+namespace
+{
+	std::wstring cache_dir(const wchar_t* name)
+	{
+		const std::filesystem::path dir = std::filesystem::temp_directory_path() / name;
+		std::error_code ec;
+		std::filesystem::remove_all(dir, ec);
+		return dir.wstring();
+	}
+}
+
+TEST(cache_round_trip)
+{
+	const std::wstring dir = cache_dir(L"QuickLinxTests-cache");
+	const CSV::ChunkCache cache(dir);
+	CHECK(cache.is_enabled());
+
+	const std::string_view chunk = "AB_ETH,ONE,10.0.0.1-5\n";
+	cache.store(42, chunk, "blob");
+
+	std::string blob;
+	CHECK(cache.load(42, chunk, blob));
+	CHECK(blob == "blob");
+
+	std::filesystem::remove_all(dir);
+}
+
+// Two chunks of the same length filed under the same key (a 64-bit key
+// collision) must not be mistaken for one another
+TEST(cache_rejects_key_collision)
+{
+	const std::wstring dir = cache_dir(L"QuickLinxTests-collision");
+	const CSV::ChunkCache cache(dir);
+
+	const std::string_view stored = "AB_ETH,ONE,10.0.0.1-5\n";
+	const std::string_view other = "AB_ETH,TWO,10.0.0.1-5\n";
+	CHECK(stored.size() == other.size());
+	CHECK(CSV::check_bytes(stored) != CSV::check_bytes(other));
+
+	cache.store(7, stored, "blob");
+
+	std::string blob;
+	CHECK(!cache.load(7, other, blob));
+	CHECK(cache.load(7, stored, blob));
+
+	std::filesystem::remove_all(dir);
+}
+
+// XXH64 reference values
+TEST(check_bytes_matches_xxh64)
+{
+	CHECK(CSV::check_bytes("") == 0xEF46DB3751D8E999ull);
+	CHECK(CSV::check_bytes("a") == 0xD24EC4F1A98C6E5Bull);
+	CHECK(CSV::check_bytes("abc") == 0x44BC2CF5AD770999ull);
+	CHECK(CSV::check_bytes("Nobody inspects the spammish repetition") == 0xFBCEA83C8A378BF1ull);
+}
@@ -0,0 +1,138 @@
+#include "Test.h"
+#include "CSV.h"
+#include "CSVEncoding.h"
+
+#include <filesystem>
+
+namespace
+{
+	using CSV::Encoding::Kind;
+
+	const char REPLACEMENT[] = "\xEF\xBF\xBD";		// U+FFFD in UTF-8
+
+	// text as UTF-16 bytes, optionally behind a BOM
+	std::string utf16(std::u16string_view text, bool big_endian, bool bom)
+	{
+		std::string bytes;
+		auto put = [&](char16_t unit)
+			{
+				const char high = static_cast<char>(unit >> 8);
+				const char low = static_cast<char>(unit & 0xFF);
+				bytes += big_endian ? high : low;
+				bytes += big_endian ? low : high;
+			};
+
+		if (bom)
+			put(u'\xFEFF');
+		for (char16_t unit : text)
+			put(unit);
+		return bytes;
+	}
+
+	std::string to_utf8(std::string_view bytes, bool big_endian)
+	{
+		std::string out;
+		CSV::Encoding::utf16_to_utf8(bytes, big_endian, out);
+		return out;
+	}
+
+	bool detected(std::string_view bytes, Kind kind, std::size_t bom_size)
+	{
+		const CSV::Encoding::Detected found = CSV::Encoding::detect(bytes);
+		return found.kind == kind && found.bom_size == bom_size;
+	}
+}
+
+TEST(detect_byte_order_marks)
+{
+	CHECK(detected("\xEF\xBB\xBFType,Name,Range\n", Kind::UTF8, 3));
+	CHECK(detected(utf16(u"Type", false, true), Kind::UTF16LE, 2));
+	CHECK(detected(utf16(u"Type", true, true), Kind::UTF16BE, 2));
+}
+
+TEST(detect_without_byte_order_mark)
+{
+	CHECK(detected(utf16(u"Type", false, false), Kind::UTF16LE, 0));
+	CHECK(detected(utf16(u"Type", true, false), Kind::UTF16BE, 0));
+	CHECK(detected("Type,Name,Range\n", Kind::UTF8, 0));
+	CHECK(detected("AB_ETH,caf\xC3\xA9,10.0.0.1\n", Kind::UTF8, 0));
+	CHECK(detected("AB_ETH,caf\xE9,10.0.0.1\n", Kind::Latin1, 0));			// Not valid UTF-8
+	CHECK(detected("", Kind::UTF8, 0));
+}
+
+TEST(utf16_to_utf8_both_byte_orders)
+{
+	// ASCII long enough for the 8-unit fast path, then 2-, 3- and 4-byte sequences
+	const std::u16string_view text = u"AB_ETH,PLANT-ONE,10.0.0.1-5 \u00E9\u20AC\U0001F600!";
+	const std::string expected = "AB_ETH,PLANT-ONE,10.0.0.1-5 \xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80!";
+
+	CHECK(to_utf8(utf16(text, false, false), false) == expected);
+	CHECK(to_utf8(utf16(text, true, false), true) == expected);
+}
+
+TEST(utf16_to_utf8_replaces_lone_surrogates)
+{
+	const char16_t high = 0xD83D;
+	const char16_t low = 0xDE00;
+
+	// A high surrogate followed by something other than a low one, a lone
+	// low surrogate, and a high surrogate as the very last unit
+	const std::u16string text = std::u16string(u"a") + high + u"b" + low + u"c" + high;
+	const std::string expected = std::string("a") + REPLACEMENT + "b" + REPLACEMENT + "c" + REPLACEMENT;
+
+	CHECK(to_utf8(utf16(text, false, false), false) == expected);
+	CHECK(to_utf8(utf16(text, true, false), true) == expected);
+}
+
+TEST(utf16_to_utf8_replaces_odd_trailing_byte)
+{
+	const std::string bytes = utf16(u"AB", false, false) + 'C';
+	CHECK(to_utf8(bytes, false) == std::string("AB") + REPLACEMENT);
+	CHECK(to_utf8("x", false) == REPLACEMENT);
+	CHECK(to_utf8("", false).empty());
+}
+
+TEST(to_wide_decodes_utf8_and_latin1)
+{
+	CHECK(CSV::Encoding::to_wide("caf\xC3\xA9", Kind::UTF8) == L"caf\u00E9");
+	CHECK(CSV::Encoding::to_wide("caf\xE9", Kind::Latin1) == L"caf\u00E9");
+	CHECK(CSV::Encoding::to_wide("a\xC3z", Kind::UTF8) == L"a\uFFFDz");			// Truncated sequence
+
+	CHECK(CSV::Encoding::wide_length("caf\xC3\xA9", Kind::UTF8) == 4);
+	CHECK(CSV::Encoding::wide_length("\xF0\x9F\x98\x80", Kind::UTF8) == 2);		// A surrogate pair in the registry
+	CHECK(CSV::Encoding::wide_length("caf\xE9", Kind::Latin1) == 4);
+}
+
+// The same file in every encoding the reader detects reads the same drivers
+TEST(read_drivers_in_every_encoding)
+{
+	const std::u16string_view csv = u"Type,Name,Range\r\nAB_ETH,CAF\u00C9,10.0.0.1-3\r\nAB_ETH,LINE-2,10.0.1.7\r\n";
+	const std::string utf8 = "Type,Name,Range\r\nAB_ETH,CAF\xC3\x89,10.0.0.1-3\r\nAB_ETH,LINE-2,10.0.1.7\r\n";
+
+	const std::string files[] = {
+		utf8,
+		"\xEF\xBB\xBF" + utf8,
+		utf16(csv, false, true),
+		utf16(csv, true, true),
+		utf16(csv, false, false),
+		utf16(csv, true, false),
+	};
+
+	for (const std::string& contents : files)
+	{
+		const std::wstring path = Test::temp_file(L"QuickLinxTests-encoding.csv", contents);
+		std::vector<EthDriver> drivers;
+		std::wstring error;
+		CHECK(CSV::read_drivers_from_file(path, drivers, error));
+		std::filesystem::remove(path);
+
+		CHECK(drivers.size() == 2);
+		if (drivers.size() != 2)
+			continue;
+
+		CHECK(drivers[0].name.view() == L"CAF\u00C9");
+		CHECK(drivers[0].nodes.size() == 3 && drivers[0].nodes[0] == 0x0A000001);
+		CHECK(drivers[1].name.view() == L"LINE-2");
+		CHECK(drivers[1].nodes.size() == 1 && drivers[1].nodes[0] == 0x0A000107);
+	}
+}
@@ -0,0 +1,342 @@
+#include "Test.h"
+#include "CSV.h"
+
+#include <algorithm>
+#include <filesystem>
+
+namespace
+{
+	constexpr std::uint32_t address(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d)
+	{
+		return (a << 24) | (b << 16) | (c << 8) | d;
+	}
+
+	bool read(const wchar_t* name, std::string_view csv, std::vector<EthDriver>& drivers)
+	{
+		const std::wstring path = Test::temp_file(name, csv);
+		std::wstring error;
+		const bool ok = CSV::read_drivers_from_file(path, drivers, error);
+		std::filesystem::remove(path);
+		return ok;
+	}
+}
+
+// A range ending at .255 must stop there, including in 255.255.255.0/24
+// where one more address wraps the 32-bit counter back to 0
+TEST(read_range_ending_at_255)
+{
+	std::vector<EthDriver> drivers;
+	CHECK(read(L"QuickLinxTests-range255.csv",
+			   "Type,Name,Range\n"
+			   "AB_ETH,TOP,255.255.255.250-255\n"
+			   "AB_ETH,LAST,10.0.0.255\n",
+			   drivers));
+
+	CHECK(drivers.size() == 2);
+	if (drivers.size() != 2)
+		return;
+
+	CHECK(drivers[0].nodes.size() == 6);
+	for (std::size_t i = 0; i < drivers[0].nodes.size(); ++i)
+		CHECK(drivers[0].nodes[i] == address(255, 255, 255, 250) + i);
+
+	CHECK(drivers[1].nodes.size() == 1);
+	CHECK(drivers[1].nodes.size() == 1 && drivers[1].nodes[0] == address(10, 0, 0, 255));
+}
+
+TEST(read_single_address_255_255_255_255)
+{
+	std::vector<EthDriver> drivers;
+	CHECK(read(L"QuickLinxTests-broadcast.csv",
+			   "Type,Name,Range\n"
+			   "AB_ETH,ALL,255.255.255.255\n",
+			   drivers));
+
+	CHECK(drivers.size() == 1);
+	CHECK(drivers.size() == 1 && drivers[0].nodes.size() == 1 && drivers[0].nodes[0] == 0xFFFFFFFFu);
+}
+
+namespace
+{
+	// ASCII text, plus U+00E9 for each '~', as UTF-16 with a BOM
+	std::string to_utf16(std::string_view ascii, bool big_endian)
+	{
+		std::string out = big_endian ? "\xFE\xFF" : "\xFF\xFE";
+		for (char c : ascii)
+		{
+			const unsigned unit = (c == '~') ? 0xE9u : static_cast<unsigned char>(c);
+			const char high = static_cast<char>(unit >> 8);
+			const char low = static_cast<char>(unit & 0xFF);
+			out += big_endian ? high : low;
+			out += big_endian ? low : high;
+		}
+		return out;
+	}
+
+	// drivers * 2 rows, enough for several streaming chunks
+	std::string many_drivers_csv(std::size_t drivers)
+	{
+		std::string csv = "Type,Name,Range\n";
+		for (std::size_t i = 0; i < drivers; ++i)
+		{
+			// 50 pairs of rows (250 nodes) per driver, each in a /24 of its own
+			const std::size_t driver = i / 50;
+			const std::string name = "AB_ETH,CAF~-" + std::to_string(driver) + ",";
+			const std::string subnet = std::to_string(10 + driver / 250) + "." + std::to_string(driver % 250) + "." + std::to_string(i % 50);
+			csv += name + subnet + ".1-4\n";
+			csv += name + subnet + ".9\n";
+		}
+		return csv;
+	}
+}
+
+// UTF-16 input streams chunk by chunk and gives the drivers a UTF-8 read does
+TEST(stream_utf16_matches_read)
+{
+	const std::string csv = many_drivers_csv(40000);
+
+	std::string utf8 = csv;
+	for (std::size_t at = utf8.find('~'); at != std::string::npos; at = utf8.find('~', at))
+		utf8.replace(at, 1, "\xC3\xA9");
+
+	std::vector<EthDriver> expected;
+	CHECK(read(L"QuickLinxTests-utf8.csv", utf8, expected));
+	std::sort(expected.begin(), expected.end(),
+		[](const EthDriver& a, const EthDriver& b) { return a.name < b.name; });
+	CHECK(!expected.empty() && expected[0].name.view().substr(0, 4) == L"CAF\u00E9");
+
+	for (bool big_endian : { false, true })
+	{
+		const std::wstring path = Test::temp_file(L"QuickLinxTests-utf16.csv", to_utf16(csv, big_endian));
+		CHECK(std::filesystem::file_size(path) > (std::size_t(4) << 20));
+
+		CSV::StreamOptions options;
+		options.memory_budget = 0;			// the smallest chunks the stream allows
+		options.threads = 2;
+
+		std::vector<EthDriver> streamed;
+		std::wstring error;
+		CHECK(CSV::stream_drivers_from_file(path, [&](EthDriver&& driver) {
+			streamed.push_back(std::move(driver));
+			return true;
+			}, error, options));
+		std::filesystem::remove(path);
+
+		CHECK(error.empty());
+		CHECK(streamed.size() == expected.size());
+		if (streamed.size() != expected.size())
+			continue;
+
+		for (std::size_t i = 0; i < streamed.size(); ++i)
+		{
+			CHECK(streamed[i].name == expected[i].name);
+			CHECK(std::equal(streamed[i].nodes.begin(), streamed[i].nodes.end(),
+							 expected[i].nodes.begin(), expected[i].nodes.end()));
+		}
+	}
+}
+
+namespace
+{
+	// Two files that both define PLANT, with overlapping nodes
+	const char FIRST_FILE[] =
+		"Type,Name,Range\n"
+		"AB_ETH,PLANT,10.0.0.1-3\n"
+		"AB_ETH,ONLY-FIRST,10.0.1.1\n";
+
+	const char SECOND_FILE[] =
+		"Type,Name,Range\n"
+		"AB_ETH,ONLY-SECOND,10.0.2.1\n"
+		"AB_ETH,PLANT,10.0.0.3-5\n";
+
+	bool read_both(	std::string_view first,
+					std::string_view second,
+					CSV::ConflictPolicy policy,
+					std::vector<EthDriver>& drivers,
+					Diagnostics::List& diagnostics,
+					std::vector<std::wstring>& paths)
+	{
+		paths = { Test::temp_file(L"QuickLinxTests-first.csv", first),
+				  Test::temp_file(L"QuickLinxTests-second.csv", second) };
+
+		const bool ok = CSV::read_drivers_from_files(paths, drivers, diagnostics, policy);
+		for (const std::wstring& path : paths)
+			std::filesystem::remove(path);
+		return ok;
+	}
+
+	bool has_nodes(const EthDriver& driver, std::uint32_t first, std::uint32_t count)
+	{
+		if (driver.nodes.size() != count)
+			return false;
+		for (std::uint32_t i = 0; i < count; ++i)
+		{
+			if (driver.nodes[i] != first + i)
+				return false;
+		}
+		return true;
+	}
+}
+
+// Drivers come out in file order; the first file's PLANT is kept as it was
+TEST(read_files_first_wins)
+{
+	std::vector<EthDriver> drivers;
+	Diagnostics::List diagnostics;
+	std::vector<std::wstring> paths;
+	CHECK(read_both(FIRST_FILE, SECOND_FILE, CSV::ConflictPolicy::FirstWins, drivers, diagnostics, paths));
+
+	CHECK(diagnostics.empty());
+	CHECK(drivers.size() == 3);
+	if (drivers.size() != 3)
+		return;
+
+	CHECK(drivers[0].name.view() == L"PLANT" && has_nodes(drivers[0], address(10, 0, 0, 1), 3));
+	CHECK(drivers[1].name.view() == L"ONLY-FIRST");
+	CHECK(drivers[2].name.view() == L"ONLY-SECOND");
+}
+
+// PLANT gets the second file's nodes it lacked, after its own
+TEST(read_files_union_nodes)
+{
+	std::vector<EthDriver> drivers;
+	Diagnostics::List diagnostics;
+	std::vector<std::wstring> paths;
+	CHECK(read_both(FIRST_FILE, SECOND_FILE, CSV::ConflictPolicy::UnionNodes, drivers, diagnostics, paths));
+
+	CHECK(diagnostics.empty());
+	CHECK(drivers.size() == 3);
+	CHECK(drivers.size() == 3 && has_nodes(drivers[0], address(10, 0, 0, 1), 5));
+}
+
+TEST(read_files_union_over_node_limit)
+{
+	std::vector<EthDriver> drivers;
+	Diagnostics::List diagnostics;
+	std::vector<std::wstring> paths;
+	CHECK(!read_both("Type,Name,Range\nAB_ETH,PLANT,10.0.0.1-200\n",
+					 "Type,Name,Range\nAB_ETH,PLANT,10.0.1.1-100\n",
+					 CSV::ConflictPolicy::UnionNodes, drivers, diagnostics, paths));
+
+	CHECK(drivers.empty());
+	CHECK(diagnostics.size() == 1);
+	CHECK(diagnostics.size() == 1 && diagnostics[0].code == Diagnostics::Code::CombinedNodeLimit);
+	CHECK(diagnostics.size() == 1 && diagnostics.text(diagnostics[0].source) == paths[1]);
+}
+
+// Each repeated driver is a problem naming both files
+TEST(read_files_conflict_error)
+{
+	std::vector<EthDriver> drivers;
+	Diagnostics::List diagnostics;
+	std::vector<std::wstring> paths;
+	CHECK(!read_both(FIRST_FILE, SECOND_FILE, CSV::ConflictPolicy::Error, drivers, diagnostics, paths));
+
+	CHECK(drivers.empty());
+	CHECK(diagnostics.size() == 1);
+	if (diagnostics.size() != 1)
+		return;
+
+	CHECK(diagnostics[0].code == Diagnostics::Code::DuplicateDriver);
+	CHECK(diagnostics.format(0) == paths[1] + L": Driver \"PLANT\" is also defined in " + paths[0] + L".");
+}
+
+// A bad row in either file fails the read whatever the policy, tagged with its file
+TEST(read_files_reports_bad_rows_per_file)
+{
+	for (CSV::ConflictPolicy policy : { CSV::ConflictPolicy::FirstWins, CSV::ConflictPolicy::UnionNodes, CSV::ConflictPolicy::Error })
+	{
+		std::vector<EthDriver> drivers;
+		Diagnostics::List diagnostics;
+		std::vector<std::wstring> paths;
+		CHECK(!read_both(FIRST_FILE, "Type,Name,Range\nAB_ETH,PLANT,10.0.0.300\n", policy, drivers, diagnostics, paths));
+
+		CHECK(drivers.empty());
+		CHECK(diagnostics.size() == 1);
+		CHECK(diagnostics.size() == 1 && diagnostics[0].line == 2 && diagnostics.text(diagnostics[0].source) == paths[1]);
+	}
+}
+
+namespace
+{
+	bool read_patch(std::string_view csv, std::vector<DriverPatch>& patches, Diagnostics::List& diagnostics)
+	{
+		const std::wstring path = Test::temp_file(L"QuickLinxTests-patch.csv", csv);
+		const bool ok = CSV::read_patch_from_file(path, patches, diagnostics);
+		std::filesystem::remove(path);
+		return ok;
+	}
+}
+
+// Changes are grouped by driver in order of first appearance, each in file order
+TEST(read_patch_add_and_remove)
+{
+	std::vector<DriverPatch> patches;
+	Diagnostics::List diagnostics;
+	CHECK(read_patch("Op,Type,Name,Range\n"
+					 "+,AB_ETH,PLANT,10.0.0.1-2\n"
+					 "\n"
+					 "-,AB_ETH,LINE-2,10.0.1.9\n"
+					 " - , AB_ETH , PLANT , 10.0.0.1 \n",
+					 patches, diagnostics));
+
+	CHECK(diagnostics.empty());
+	CHECK(patches.size() == 2);
+	if (patches.size() != 2)
+		return;
+
+	CHECK(patches[0].name.view() == L"PLANT");
+	CHECK(patches[0].changes.size() == 3);
+	if (patches[0].changes.size() == 3)
+	{
+		CHECK(patches[0].changes[0].op == PatchOp::Add && patches[0].changes[0].node == address(10, 0, 0, 1) && patches[0].changes[0].line == 2);
+		CHECK(patches[0].changes[1].op == PatchOp::Add && patches[0].changes[1].node == address(10, 0, 0, 2) && patches[0].changes[1].line == 2);
+		CHECK(patches[0].changes[2].op == PatchOp::Remove && patches[0].changes[2].node == address(10, 0, 0, 1) && patches[0].changes[2].line == 5);
+	}
+
+	CHECK(patches[1].name.view() == L"LINE-2");
+	CHECK(patches[1].changes.size() == 1);
+	CHECK(patches[1].changes.size() == 1 && patches[1].changes[0].op == PatchOp::Remove && patches[1].changes[0].node == address(10, 0, 1, 9));
+}
+
+// Every bad row is reported with its line, and no patch is returned
+TEST(read_patch_reports_malformed_rows)
+{
+	std::vector<DriverPatch> patches;
+	Diagnostics::List diagnostics;
+	CHECK(!read_patch("Op,Type,Name,Range\n"
+					  "+,AB_ETH,PLANT,10.0.0.1\n"
+					  "*,AB_ETH,PLANT,10.0.0.2\n"
+					  "+,AB_ETH,PLANT\n"
+					  "-,AB_ETH,,10.0.0.3\n"
+					  "+,AB_ETH,PLANT,10.0.0.9-4\n"
+					  "+,PCCC,PLANT,10.0.0.5\n"
+					  "-,AB_ETH,PLANT,10.0.0\n",
+					  patches, diagnostics));
+
+	CHECK(patches.empty());
+	CHECK(diagnostics.size() == 6);
+	if (diagnostics.size() != 6)
+		return;
+
+	using Diagnostics::Code;
+	CHECK(diagnostics[0].code == Code::UnsupportedOp && diagnostics[0].line == 3 && diagnostics.text(diagnostics[0].text) == L"*");
+	CHECK(diagnostics[1].code == Code::PatchColumnCount && diagnostics[1].line == 4);
+	CHECK(diagnostics[2].code == Code::EmptyName && diagnostics[2].line == 5);
+	CHECK(diagnostics[3].code == Code::BadRange && diagnostics[3].line == 6);
+	CHECK(diagnostics[4].code == Code::UnsupportedType && diagnostics[4].line == 7);
+	CHECK(diagnostics[5].code == Code::BadAddress && diagnostics[5].line == 8);
+}
+
+TEST(read_patch_rejects_bad_header)
+{
+	std::vector<DriverPatch> patches;
+	Diagnostics::List diagnostics;
+	CHECK(!read_patch("Type,Name,Range\nAB_ETH,PLANT,10.0.0.1\n", patches, diagnostics));
+	CHECK(diagnostics.size() == 1 && diagnostics[0].code == Diagnostics::Code::PatchHeader);
+
+	diagnostics.clear();
+	CHECK(!read_patch("", patches, diagnostics));
+	CHECK(diagnostics.size() == 1 && diagnostics[0].code == Diagnostics::Code::EmptyFile);
+	CHECK(patches.empty());
+}
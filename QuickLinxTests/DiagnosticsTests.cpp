@@ -0,0 +1,80 @@
+#include "Test.h"
+#include "Diagnostics.h"
+
+using Diagnostics::Code;
+
+// Strings come back out of the pool as they went in, and only when a message is formatted
+TEST(diagnostics_intern_and_format)
+{
+	Diagnostics::List list;
+	CHECK(list.add(Code::NameTooLong, 7, Diagnostics::COLUMN_NAME, {}, L"A-VERY-LONG-DRIVER-NAME"));
+	CHECK(list.add(Code::DuplicateNode, 9, Diagnostics::COLUMN_RANGE, L"PLANT", {}, 0x0A000105));
+	CHECK(list.add(Code::DuplicateDriver, 0, Diagnostics::COLUMN_NONE, L"PLANT", L"first.csv", 0, L"second.csv"));
+
+	CHECK(list.size() == 3);
+	CHECK(list[0].line == 7 && list[0].column == Diagnostics::COLUMN_NAME);
+	CHECK(list.text(list[0].text) == L"A-VERY-LONG-DRIVER-NAME");
+	CHECK(list.text(list[1].driver) == L"PLANT");
+	CHECK(list[1].value == 0x0A000105);
+	CHECK(list.text(list[2].source) == L"second.csv");
+
+	CHECK(list.format(0) == L"Line 7: driver name \"A-VERY-LONG-DRIVER-NAME\" exceeds 15-character limit.");
+	CHECK(list.format(1) == L"Line 9: duplicate node IP \"10.0.1.5\" for driver \"PLANT\".");
+	CHECK(list.format(2) == L"second.csv: Driver \"PLANT\" is also defined in first.csv.");
+	CHECK(list.format_all() == list.format(0) + L"\n" + list.format(1) + L"\n" + list.format(2) + L"\n");
+}
+
+// Empty driver, text and source all leave the pool alone
+TEST(diagnostics_empty_strings_are_not_pooled)
+{
+	Diagnostics::List list;
+	CHECK(list.add(Code::EmptyName, 3, Diagnostics::COLUMN_NAME));
+	CHECK(list.add(Code::BadRange, 4, Diagnostics::COLUMN_RANGE, L"", L"", 0, L""));
+
+	for (const Diagnostics::Record& record : list)
+	{
+		CHECK(record.driver == Diagnostics::NO_TEXT);
+		CHECK(record.text == Diagnostics::NO_TEXT);
+		CHECK(record.source == Diagnostics::NO_TEXT);
+	}
+
+	// The first string pooled after them still gets id 0
+	CHECK(list.add(Code::OpenFailed, 0, Diagnostics::COLUMN_NONE, {}, L"missing.csv"));
+	CHECK(list[2].text == 0);
+	CHECK(list.format(2) == L"Failed to open CSV file: missing.csv");
+	CHECK(list.format(0) == L"Line 3: Name field is empty.");
+}
+
+// Copying a record into another list brings its strings along
+TEST(diagnostics_copy_between_lists)
+{
+	Diagnostics::List file_list;
+	CHECK(file_list.add(Code::BadAddress, 12, Diagnostics::COLUMN_RANGE, L"PLANT", L"10.0.0.999"));
+
+	Diagnostics::List combined;
+	CHECK(combined.add(Code::EmptyFile));
+	CHECK(combined.add(file_list, 0, L"site-a.csv"));
+	CHECK(combined.add(file_list, 0));
+
+	CHECK(combined.size() == 3);
+	CHECK(combined.format(1) == L"site-a.csv: Line 12: Range \"10.0.0.999\" is neither a valid IPv4 address nor a valid range.");
+	CHECK(combined.format(2) == L"Line 12: Range \"10.0.0.999\" is neither a valid IPv4 address nor a valid range.");
+	CHECK(combined.text(combined[1].driver) == L"PLANT");
+}
+
+TEST(diagnostics_limit_truncates)
+{
+	Diagnostics::List list(2);
+	CHECK(list.add(Code::EmptyName, 2));
+	CHECK(list.add(Code::EmptyName, 3));
+	CHECK(list.full() && !list.truncated());
+
+	CHECK(!list.add(Code::EmptyName, 4, Diagnostics::COLUMN_NAME, L"PLANT", L"text"));
+	CHECK(list.truncated());
+	CHECK(list.size() == 2);
+	CHECK(list.format_all() == L"Line 2: Name field is empty.\nLine 3: Name field is empty.\nStopped after 2 errors.\n");
+
+	list.clear();
+	CHECK(list.empty() && !list.truncated() && !list.full());
+	CHECK(list.format_all().empty());
+}
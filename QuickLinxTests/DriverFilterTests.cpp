@@ -0,0 +1,126 @@
+#include "Test.h"
+#include "DriverFilter.h"
+
+namespace
+{
+	DriverFilter name_filter(const wchar_t* glob)
+	{
+		DriverFilter filter;
+		filter.name_glob = glob;
+		return filter;
+	}
+
+	DriverFilter subnet_filter(std::initializer_list<const wchar_t*> subnets)
+	{
+		DriverFilter filter;
+		std::wstring error;
+		std::wstring list;
+		for (const wchar_t* subnet : subnets)
+			list += std::wstring(subnet) + L",";
+		CHECK(DriverFilter::parse(L"", list, filter, error));
+		return filter;
+	}
+
+	NodeList nodes(std::initializer_list<std::uint32_t> addresses)
+	{
+		NodeList list;
+		for (std::uint32_t address : addresses)
+			list.push_back(address);
+		return list;
+	}
+}
+
+TEST(filter_empty_pattern_matches_any_name)
+{
+	const DriverFilter filter;
+	CHECK(filter.is_empty());
+	CHECK(filter.matches_name(L"PLANT"));
+	CHECK(filter.matches_name(L""));
+	CHECK(filter.matches_nodes(NodeList()));
+}
+
+TEST(filter_name_ignores_case)
+{
+	const DriverFilter filter = name_filter(L"Site-42");
+	CHECK(!filter.is_empty());
+	CHECK(filter.matches_name(L"SITE-42"));
+	CHECK(filter.matches_name(L"site-42"));
+	CHECK(!filter.matches_name(L"SITE-420"));
+	CHECK(!filter.matches_name(L"SITE-4"));
+	CHECK(!filter.matches_name(L""));
+}
+
+TEST(filter_name_star)
+{
+	const DriverFilter prefix = name_filter(L"SITE-42*");
+	CHECK(prefix.matches_name(L"SITE-42"));
+	CHECK(prefix.matches_name(L"site-42-line-7"));
+	CHECK(!prefix.matches_name(L"SITE-4"));
+	CHECK(!prefix.matches_name(L"XSITE-42"));
+
+	const DriverFilter suffix = name_filter(L"*-TEST");
+	CHECK(suffix.matches_name(L"PLANT-TEST"));
+	CHECK(suffix.matches_name(L"-TEST"));
+	CHECK(!suffix.matches_name(L"PLANT-TEST2"));
+
+	// A later '*' has to give back characters an earlier one took
+	const DriverFilter middle = name_filter(L"A*B*C");
+	CHECK(middle.matches_name(L"ABC"));
+	CHECK(middle.matches_name(L"AxxBxBxC"));
+	CHECK(!middle.matches_name(L"AxxCxB"));
+
+	CHECK(name_filter(L"*").matches_name(L""));
+	CHECK(name_filter(L"**").matches_name(L"ANY"));
+}
+
+TEST(filter_name_question_mark)
+{
+	const DriverFilter filter = name_filter(L"LINE-?");
+	CHECK(filter.matches_name(L"LINE-1"));
+	CHECK(filter.matches_name(L"line-x"));
+	CHECK(!filter.matches_name(L"LINE-"));
+	CHECK(!filter.matches_name(L"LINE-12"));
+
+	CHECK(name_filter(L"?*").matches_name(L"A"));
+	CHECK(!name_filter(L"?*").matches_name(L""));
+}
+
+TEST(filter_subnets)
+{
+	const DriverFilter filter = subnet_filter({ L"10.20.0.0/16", L"192.168.1.7/32" });
+	CHECK(filter.subnets.size() == 2);
+
+	CHECK(filter.matches_nodes(nodes({ 0x0A000001, 0x0A140305 })));			// 10.20.3.5
+	CHECK(filter.matches_nodes(nodes({ 0xC0A80107 })));						// 192.168.1.7
+	CHECK(!filter.matches_nodes(nodes({ 0xC0A80108, 0x0A150000 })));		// 192.168.1.8, 10.21.0.0
+	CHECK(!filter.matches_nodes(NodeList()));
+
+	// Host bits in the text are ignored; /0 matches any address
+	const DriverFilter loose = subnet_filter({ L"10.20.30.40/8" });
+	CHECK(loose.matches_nodes(nodes({ 0x0AFFFFFF })));
+	CHECK(subnet_filter({ L"0.0.0.0/0" }).matches_nodes(nodes({ 0xC0A80101 })));
+}
+
+TEST(filter_parse)
+{
+	DriverFilter filter;
+	std::wstring error;
+	CHECK(DriverFilter::parse(L"  SITE-42*  ", L" 10.20.0.0/16;192.168.1.0/24 , 172.16.0.0/12 ", filter, error));
+	CHECK(filter.name_glob == L"SITE-42*");
+	CHECK(filter.subnets.size() == 3);
+	CHECK(filter.subnets.size() == 3 && filter.subnets[2].network == 0xAC100000 && filter.subnets[2].mask == 0xFFF00000);
+
+	DriverFilter empty;
+	CHECK(DriverFilter::parse(L" ", L" , ", empty, error));
+	CHECK(empty.is_empty());
+
+	// A bad subnet leaves the filter as it was
+	for (const wchar_t* bad : { L"10.20.0.0", L"10.20.0.0/33", L"10.20.0/16", L"SITE-42" })
+	{
+		DriverFilter kept = filter;
+		error.clear();
+		CHECK(!DriverFilter::parse(L"OTHER", std::wstring(L"10.0.0.0/8, ") + bad, kept, error));
+		CHECK(kept.name_glob == L"SITE-42*" && kept.subnets.size() == 3);
+		CHECK(error.find(bad) != std::wstring::npos);
+	}
+}
@@ -0,0 +1,75 @@
+#include "Test.h"
+#include "DriverName.h"
+
+#include <unordered_set>
+#include <utility>
+
+namespace
+{
+	const wchar_t LONG_NAME[] = L"Packaging-Line-07";			// 17 characters
+	const wchar_t LONG_FOLDED[] = L"packaging-line-07";
+}
+
+TEST(driver_name_short_and_long)
+{
+	const DriverName short_name(L"PLANT");
+	CHECK(short_name.size() == 5 && short_name.view() == L"PLANT" && short_name.folded() == L"plant");
+	CHECK(short_name.c_str()[5] == L'\0');
+	CHECK(DriverName::fits(short_name.view()));
+
+	// Over the RSLinx limit the whole name is still kept
+	const DriverName long_name(LONG_NAME);
+	CHECK(!DriverName::fits(LONG_NAME));
+	CHECK(long_name.size() == 17);
+	CHECK(long_name.view() == LONG_NAME && long_name.str() == LONG_NAME);
+	CHECK(long_name.folded() == LONG_FOLDED);
+	CHECK(long_name.c_str()[17] == L'\0');
+
+	const DriverName sixteen(L"ABCDEFGHIJKLMNOP");
+	CHECK(sixteen.size() == 16 && sixteen.view() == L"ABCDEFGHIJKLMNOP");
+}
+
+TEST(driver_name_long_compare_and_hash)
+{
+	const DriverName name(LONG_NAME);
+	const DriverName same(LONG_NAME);
+	const DriverName other_case(L"PACKAGING-LINE-07");
+	const DriverName prefix(L"Packaging-Line-");			// 15 characters, stored inline
+
+	CHECK(name == same && !(name != same));
+	CHECK(name != other_case && name.iequals(other_case));
+	CHECK(name.hash() == other_case.hash());
+	CHECK(name != prefix && !name.iequals(prefix));
+	CHECK(prefix < name);
+
+	std::unordered_set<DriverName, std::hash<DriverName>, DriverName::CaseInsensitiveEqual> names;
+	names.insert(name);
+	names.insert(prefix);
+	CHECK(names.count(other_case) == 1);
+	CHECK(names.size() == 2);
+}
+
+TEST(driver_name_long_copy_and_move)
+{
+	DriverName name(LONG_NAME);
+
+	DriverName copy = name;
+	CHECK(copy == name && copy.c_str() != name.c_str());
+
+	DriverName moved = std::move(copy);
+	CHECK(moved == name);
+	CHECK(copy.empty() && copy.view().empty() && copy == DriverName());
+
+	// Short over long, long over short, and a name assigned its own text
+	moved = DriverName(L"LINE-2");
+	CHECK(moved.view() == L"LINE-2" && moved == DriverName(L"LINE-2"));
+	moved = name;
+	CHECK(moved.view() == LONG_NAME);
+	moved.assign(moved.view());
+	CHECK(moved == name);
+	moved.assign(moved.view().substr(0, 4));
+	CHECK(moved.view() == L"Pack" && moved == DriverName(L"Pack"));
+
+	name.clear();
+	CHECK(name.empty() && name == DriverName());
+}
@@ -0,0 +1,147 @@
+#include "Test.h"
+#include "DriverSnapshot.h"
+
+#include <algorithm>
+#include <filesystem>
+
+namespace
+{
+	EthDriver make_driver(const wchar_t* key_name, const wchar_t* name, std::uint32_t first_node)
+	{
+		EthDriver driver = {};
+		driver.key_name = DriverName(key_name);
+		driver.name = DriverName(name);
+		driver.station = 63;
+		driver.ping_timeout = 3;
+		driver.inactivity_timeout = 30;
+		driver.startup = 1;
+		for (std::uint32_t n = 0; n < 4; ++n)
+			driver.nodes.push_back(first_node + n);
+		return driver;
+	}
+
+	bool contains(const std::vector<std::wstring>& keys, const wchar_t* key)
+	{
+		return std::find(keys.begin(), keys.end(), key) != keys.end();
+	}
+}
+
+// A backup records every key it saw. Keys it could not read as a driver
+// (here one missing its Station and one that failed to read) are kept
+// by restore; only keys created after the backup are deleted.
+TEST(snapshot_keeps_keys_backup_could_not_read)
+{
+	const std::vector<EthDriver> drivers = {
+		make_driver(L"AB_ETH-1", L"LINE1", 0x0A000001),
+		make_driver(L"AB_ETH-2", L"LINE2", 0x0A000101),
+	};
+
+	// As backup() gets them from EnumerateDriverKeys: the two readable drivers
+	// plus AB_ETH-3 (unreadable) and AB_ETH-4 (no Station value)
+	const std::vector<std::wstring> key_names = { L"AB_ETH-1", L"AB_ETH-2", L"AB_ETH-3", L"AB_ETH-4" };
+
+	const std::wstring path = (std::filesystem::temp_directory_path() / L"QuickLinxTests.qlxb").wstring();
+	std::wstring error;
+	CHECK(DriverSnapshot::write_snapshot(path, drivers, error, key_names));
+
+	DriverSnapshot::View view;
+	CHECK(view.open(path, error));
+	CHECK(view.driver_count() == 2);
+	CHECK(view.key_count() == 4);
+
+	EthDriver restored;
+	for (std::size_t i = 0; i < view.driver_count() && i < drivers.size(); ++i)
+	{
+		view.to_driver(i, restored);
+		CHECK(restored.key_name == drivers[i].key_name);
+		CHECK(restored.name == drivers[i].name);
+		CHECK(std::equal(restored.nodes.begin(), restored.nodes.end(), drivers[i].nodes.begin(), drivers[i].nodes.end()));
+	}
+
+	// Registry at restore time: AB_ETH-5 and AB_ETH-6 were added since
+	const std::vector<std::wstring> existing = { L"AB_ETH-1", L"AB_ETH-3", L"AB_ETH-4", L"AB_ETH-5", L"AB_ETH-6" };
+	const std::vector<std::wstring> stale = DriverSnapshot::keys_to_delete(view, existing);
+
+	CHECK(stale.size() == 2);
+	CHECK(contains(stale, L"AB_ETH-5"));
+	CHECK(contains(stale, L"AB_ETH-6"));
+	CHECK(!contains(stale, L"AB_ETH-3"));
+	CHECK(!contains(stale, L"AB_ETH-4"));
+
+	view.close();
+	std::filesystem::remove(path);
+}
+
+// Without a key list the drivers' own keys are still recorded
+TEST(snapshot_lists_driver_keys)
+{
+	const std::vector<EthDriver> drivers = { make_driver(L"AB_ETH-9", L"ONLY", 0x0A000001) };
+
+	const std::wstring path = (std::filesystem::temp_directory_path() / L"QuickLinxTests-keys.qlxb").wstring();
+	std::wstring error;
+	CHECK(DriverSnapshot::write_snapshot(path, drivers, error));
+
+	DriverSnapshot::View view;
+	CHECK(view.open(path, error));
+	CHECK(view.key_count() == 1);
+	CHECK(view.key_count() == 1 && view.key(0) == u"AB_ETH-9");
+	CHECK(DriverSnapshot::keys_to_delete(view, { L"AB_ETH-9" }).empty());
+
+	view.close();
+	std::filesystem::remove(path);
+}
+
+// Text entries come back between the addresses where they were backed up
+TEST(snapshot_keeps_text_node_slots)
+{
+	EthDriver driver = make_driver(L"AB_ETH-1", L"HOSTS", 0x0A000001);
+	driver.extra_nodes.push_back({ 0, L"plc-0.local" });
+	driver.extra_nodes.push_back({ 2, L"plc-2.local" });
+	driver.extra_nodes.push_back({ 4, L"plc-4.local" });
+
+	const std::wstring path = (std::filesystem::temp_directory_path() / L"QuickLinxTests-text.qlxb").wstring();
+	std::wstring error;
+	CHECK(DriverSnapshot::write_snapshot(path, { driver }, error));
+
+	DriverSnapshot::View view;
+	CHECK(view.open(path, error));
+	CHECK(view.driver_count() == 1);
+	if (view.driver_count() == 1)
+	{
+		EthDriver restored;
+		view.to_driver(0, restored);
+		CHECK(std::equal(restored.nodes.begin(), restored.nodes.end(), driver.nodes.begin(), driver.nodes.end()));
+		CHECK(restored.extra_nodes == driver.extra_nodes);
+	}
+
+	view.close();
+	std::filesystem::remove(path);
+}
+
+// A name over the RSLinx limit is backed up and restored in full
+TEST(snapshot_keeps_long_names)
+{
+	const std::vector<EthDriver> drivers = {
+		make_driver(L"AB_ETH-1", L"Packaging-Line-07", 0x0A000001),
+		make_driver(L"AB_ETH-2", L"LINE2", 0x0A000101),
+	};
+
+	const std::wstring path = (std::filesystem::temp_directory_path() / L"QuickLinxTests-long.qlxb").wstring();
+	std::wstring error;
+	CHECK(DriverSnapshot::write_snapshot(path, drivers, error));
+
+	DriverSnapshot::View view;
+	CHECK(view.open(path, error));
+	CHECK(view.driver_count() == 2);
+
+	EthDriver restored;
+	for (std::size_t i = 0; i < view.driver_count() && i < drivers.size(); ++i)
+	{
+		view.to_driver(i, restored);
+		CHECK(restored.key_name == drivers[i].key_name);
+		CHECK(restored.name == drivers[i].name);
+	}
+
+	view.close();
+	std::filesystem::remove(path);
+}
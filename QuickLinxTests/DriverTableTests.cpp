@@ -0,0 +1,84 @@
+#include "Test.h"
+#include "DriverTable.h"
+
+#include <algorithm>
+
+namespace
+{
+	EthDriver make_driver(const wchar_t* key_name, const wchar_t* name, std::initializer_list<std::uint32_t> nodes)
+	{
+		EthDriver driver = {};
+		driver.key_name = DriverName(key_name);
+		driver.name = DriverName(name);
+		driver.station = 63;
+		for (const std::uint32_t address : nodes)
+			driver.nodes.push_back(address);
+		return driver;
+	}
+
+	// Rows 0 and 2 have no nodes, so they share an offset with the row after them
+	std::vector<EthDriver> sample_drivers()
+	{
+		std::vector<EthDriver> drivers = {
+			make_driver(L"AB_ETH-1", L"EMPTY", {}),
+			make_driver(L"AB_ETH-2", L"PLANT", { 0x0A000001, 0x0A000002 }),
+			make_driver(L"AB_ETH-3", L"HOSTS", {}),
+			make_driver(L"AB_ETH-4", L"Packaging-Line-07", { 0x0A000003, 0x0A000001 }),
+			make_driver(L"AB_ETH-5", L"PLANT", { 0x0A000004 }),
+		};
+		drivers[2].extra_nodes.push_back({ 0, L"a-host-name-longer-than-any-small-string-buffer.local" });
+		drivers[3].extra_nodes.push_back({ 1, L"plc-7" });
+		return drivers;
+	}
+}
+
+// Rows copy back out as they went in, and text entries live in the table's resource
+TEST(driver_table_round_trip)
+{
+	const std::vector<EthDriver> drivers = sample_drivers();
+
+	std::pmr::monotonic_buffer_resource arena;
+	const DriverTable table(drivers, &arena);
+	CHECK(table.size() == drivers.size());
+
+	const std::vector<EthDriver> copied = table.to_drivers();
+	CHECK(copied.size() == drivers.size());
+	for (std::size_t row = 0; row < std::min(copied.size(), drivers.size()); ++row)
+	{
+		CHECK(copied[row].key_name == drivers[row].key_name);
+		CHECK(copied[row].name == drivers[row].name);
+		CHECK(copied[row].nodes == drivers[row].nodes);
+		CHECK(copied[row].extra_nodes == drivers[row].extra_nodes);
+		CHECK(table.node_count(row) == drivers[row].nodes.size() + drivers[row].extra_nodes.size());
+	}
+
+	const DriverTable::Slice<std::pmr::wstring> text = table.extra_nodes(2);
+	CHECK(text.size() == 1);
+	CHECK(text.size() == 1 && text[0].get_allocator().resource() == &arena);
+}
+
+// find matches the exact name and takes the first row that has it
+TEST(driver_table_find)
+{
+	const DriverTable table(sample_drivers());
+
+	CHECK(table.find(DriverName(L"EMPTY")) == 0);
+	CHECK(table.find(DriverName(L"PLANT")) == 1);
+	CHECK(table.find(DriverName(L"Packaging-Line-07")) == 3);
+	CHECK(table.find(DriverName(L"plant")) == DriverTable::npos);
+	CHECK(table.find(DriverName(L"MISSING")) == DriverTable::npos);
+	CHECK(DriverTable().find(DriverName(L"PLANT")) == DriverTable::npos);
+}
+
+// find_node takes the first row holding the address, past rows without nodes
+TEST(driver_table_find_node)
+{
+	const DriverTable table(sample_drivers());
+
+	CHECK(table.find_node(0x0A000001) == 1);
+	CHECK(table.find_node(0x0A000002) == 1);
+	CHECK(table.find_node(0x0A000003) == 3);			// Row 2 (no nodes) starts at the same offset
+	CHECK(table.find_node(0x0A000004) == 4);
+	CHECK(table.find_node(0x0A000009) == DriverTable::npos);
+	CHECK(DriverTable().find_node(0x0A000001) == DriverTable::npos);
+}
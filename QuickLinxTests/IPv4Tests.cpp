@@ -0,0 +1,119 @@
+#include "Test.h"
+#include "IPv4.h"
+
+#include <string_view>
+
+// The parsers are constexpr, so most of these cases are checked by the compiler
+namespace
+{
+	using IPv4::ParseError;
+
+	constexpr ParseError address_error(std::string_view s)
+	{
+		std::uint32_t address = 0;
+		return IPv4::parse_address(s, address);
+	}
+
+	// The parsed address, or 0xDEADBEEF if s did not parse
+	constexpr std::uint32_t address_of(std::string_view s)
+	{
+		std::uint32_t address = 0;
+		return IPv4::parse_address(s, address) == ParseError::None ? address : 0xDEADBEEF;
+	}
+
+	constexpr ParseError range_error(std::string_view s)
+	{
+		IPv4::Range range;
+		return IPv4::parse_range(s, range);
+	}
+
+	constexpr bool range_is(std::string_view s, std::uint32_t first, std::uint32_t last)
+	{
+		IPv4::Range range;
+		return IPv4::parse_range(s, range) == ParseError::None && range.first == first && range.last == last;
+	}
+
+	constexpr bool subnet_is(std::string_view s, std::uint32_t network, std::uint32_t mask)
+	{
+		IPv4::Subnet subnet;
+		return IPv4::parse_subnet(s, subnet) == ParseError::None && subnet.network == network && subnet.mask == mask;
+	}
+
+	constexpr bool formats_as(std::uint32_t address, std::string_view expected)
+	{
+		char buf[16] = {};
+		return std::string_view(buf, IPv4::format(address, buf)) == expected;
+	}
+
+	// Valid addresses
+	static_assert(address_of("10.0.0.1") == 0x0A000001, "");
+	static_assert(address_of("0.0.0.0") == 0x00000000, "");
+	static_assert(address_of("255.255.255.255") == 0xFFFFFFFF, "");
+	static_assert(address_of(" \t192.168.1.10\r\n") == 0xC0A8010A, "");
+
+	// Leading zeros are decimal, not octal
+	static_assert(address_of("010.0.0.1") == 0x0A000001, "");
+	static_assert(address_of("000.000.000.009") == 0x00000009, "");
+	static_assert(address_of("0255.1.1.1") == 0xFF010101, "");
+
+	// An octet over 255, however many digits
+	static_assert(address_error("256.0.0.1") == ParseError::Overflow, "");
+	static_assert(address_error("1.2.3.999") == ParseError::Overflow, "");
+	static_assert(address_error("1.2.3.99999999999999999999") == ParseError::Overflow, "");
+
+	// Empty input or an empty octet
+	static_assert(address_error("") == ParseError::Empty, "");
+	static_assert(address_error("   ") == ParseError::Empty, "");
+	static_assert(address_error("1..2.3") == ParseError::OctetCount, "");
+	static_assert(address_error(".1.2.3") == ParseError::OctetCount, "");
+	static_assert(address_error("1.2.3.") == ParseError::OctetCount, "");
+
+	// Trailing junk, signs and inner whitespace
+	static_assert(address_error("1.2.3.4x") == ParseError::BadDigit, "");
+	static_assert(address_error("1.2.3.4 5") == ParseError::BadDigit, "");
+	static_assert(address_error("1.2.3.4/24") == ParseError::BadDigit, "");
+	static_assert(address_error("+1.2.3.4") == ParseError::BadDigit, "");
+	static_assert(address_error("1. 2.3.4") == ParseError::BadDigit, "");
+
+	// Too many or too few dots
+	static_assert(address_error("1.2.3.4.5") == ParseError::OctetCount, "");
+	static_assert(address_error("1.2.3") == ParseError::OctetCount, "");
+	static_assert(address_error("1") == ParseError::OctetCount, "");
+
+	// Ranges
+	static_assert(range_is("10.0.0.1-5", 0x0A000001, 0x0A000005), "");
+	static_assert(range_is("10.0.0. 7 - 7 ", 0x0A000007, 0x0A000007), "");
+	static_assert(range_is("255.255.255.250-255", 0xFFFFFFFA, 0xFFFFFFFF), "");
+	static_assert(range_error("10.0.0.5-1") == ParseError::BadRange, "");
+	static_assert(range_error("10.0.0.1-256") == ParseError::BadRange, "");
+	static_assert(range_error("10.0.0.1-") == ParseError::BadRange, "");
+	static_assert(range_error("10.0.0.1") == ParseError::BadRange, "");
+	static_assert(range_error("10.0.1-5") == ParseError::OctetCount, "");
+	static_assert(range_error("10.300.0.1-5") == ParseError::Overflow, "");
+
+	// Subnets
+	static_assert(subnet_is("10.20.30.40/16", 0x0A140000, 0xFFFF0000), "");
+	static_assert(subnet_is("10.20.30.40/32", 0x0A141E28, 0xFFFFFFFF), "");
+	static_assert(subnet_is("10.20.30.40/0", 0, 0), "");
+
+	// Formatting
+	static_assert(formats_as(0x0A000001, "10.0.0.1"), "");
+	static_assert(formats_as(0x00000000, "0.0.0.0"), "");
+	static_assert(formats_as(0xFFFFFFFF, "255.255.255.255"), "");
+	static_assert(formats_as(0xC0A8640A, "192.168.100.10"), "");
+}
+
+// Wide input parses the same way, and to_wstring undoes parse_address
+TEST(ipv4_wide_round_trip)
+{
+	for (const wchar_t* text : { L"10.0.0.1", L"0.0.0.0", L"255.255.255.255", L"172.16.254.3" })
+	{
+		std::uint32_t address = 0;
+		CHECK(IPv4::parse_address(std::wstring_view(text), address) == ParseError::None);
+		CHECK(IPv4::to_wstring(address) == text);
+	}
+
+	std::uint32_t address = 0;
+	CHECK(IPv4::parse_address(std::wstring_view(L"010.001.000.001"), address) == ParseError::None);
+	CHECK(IPv4::to_wstring(address) == L"10.1.0.1");
+}
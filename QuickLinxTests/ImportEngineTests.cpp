@@ -0,0 +1,111 @@
+#include "Test.h"
+#include "ImportEngine.h"
+#include "DriverTable.h"
+
+#include <algorithm>
+
+namespace
+{
+	EthDriver make_driver(const wchar_t* key_name, const wchar_t* name, std::uint32_t first_node, std::uint32_t count)
+	{
+		EthDriver driver = {};
+		driver.key_name = DriverName(key_name);
+		driver.name = DriverName(name);
+		driver.station = 63;
+		for (std::uint32_t n = 0; n < count; ++n)
+			driver.nodes.push_back(first_node + n);
+		return driver;
+	}
+
+	bool same_nodes(const EthDriver& driver, const EthDriver& expected)
+	{
+		return std::equal(driver.nodes.begin(), driver.nodes.end(), expected.nodes.begin(), expected.nodes.end()) &&
+			   driver.extra_nodes == expected.extra_nodes;
+	}
+}
+
+// Overwrite replaces the whole Node Table, host-name entries included
+TEST(overwrite_replaces_host_name_nodes)
+{
+	EthDriver registry = make_driver(L"AB_ETH-1", L"PLANT", 0x0A000001, 3);
+	registry.extra_nodes.push_back({ 3, L"plc-1.local" });
+
+	const EthDriver csv = make_driver(L"", L"PLANT", 0xC0A80001, 2);
+
+	const ImportEngine::ImportResult result = ImportEngine::overwrite_drivers(
+		std::vector<EthDriver>{ registry }, std::vector<EthDriver>{ csv });
+
+	CHECK(result.success);
+	CHECK(result.new_drivers.empty());
+	CHECK(result.updated_drivers.size() == 1);
+	if (result.updated_drivers.size() != 1)
+		return;
+
+	const EthDriver& updated = result.updated_drivers[0];
+	CHECK(updated.key_name == registry.key_name);
+	CHECK(updated.extra_nodes.empty());
+	CHECK(same_nodes(updated, csv));
+}
+
+// Merge keeps host-name entries and adds the CSV's addresses
+TEST(merge_keeps_host_name_nodes)
+{
+	EthDriver registry = make_driver(L"AB_ETH-1", L"PLANT", 0x0A000001, 3);
+	registry.extra_nodes.push_back({ 1, L"plc-1.local" });
+
+	const EthDriver csv = make_driver(L"", L"PLANT", 0x0A000003, 2);
+
+	const ImportEngine::ImportResult result = ImportEngine::merge_drivers(
+		DriverTable(std::vector<EthDriver>{ registry }), DriverTable(std::vector<EthDriver>{ csv }));
+
+	CHECK(result.success);
+	CHECK(result.updated_drivers.size() == 1);
+	if (result.updated_drivers.size() != 1)
+		return;
+
+	const EthDriver& updated = result.updated_drivers[0];
+	CHECK(updated.extra_nodes == registry.extra_nodes);			// Still after the first address
+	CHECK(updated.nodes.size() == 4);
+	CHECK(updated.nodes.contains(0x0A000004));
+}
+
+// Removing an address moves the text entries after it up with the addresses
+TEST(patch_remove_keeps_host_name_slots)
+{
+	EthDriver registry = make_driver(L"AB_ETH-1", L"PLANT", 0x0A000001, 3);
+	registry.extra_nodes.push_back({ 0, L"plc-0.local" });
+	registry.extra_nodes.push_back({ 2, L"plc-2.local" });
+
+	DriverPatch patch;
+	patch.name = registry.name;
+	patch.changes.push_back({ PatchOp::Remove, 0x0A000001, 2 });
+
+	const ImportEngine::ImportResult result = ImportEngine::apply_patch(
+		DriverTable(std::vector<EthDriver>{ registry }), std::vector<DriverPatch>{ patch });
+
+	CHECK(result.updated_drivers.size() == 1);
+	if (result.updated_drivers.size() != 1)
+		return;
+
+	const EthDriver& updated = result.updated_drivers[0];
+	CHECK(updated.nodes.size() == 2 && updated.nodes[0] == 0x0A000002);
+	CHECK(updated.extra_nodes.size() == 2);
+	CHECK(updated.extra_nodes.size() == 2 && updated.extra_nodes[0].addresses_before == 0 && updated.extra_nodes[1].addresses_before == 1);
+}
+
+// A registry driver whose name is over the RSLinx limit still holds its key,
+// so a new driver is not given that key and saved over it
+TEST(merge_skips_key_of_long_named_driver)
+{
+	const std::vector<EthDriver> registry = {
+		make_driver(L"AB_ETH-1", L"PLANT", 0x0A000001, 1),
+		make_driver(L"AB_ETH-2", L"Packaging-Line-07", 0x0A000101, 1),
+	};
+	const std::vector<EthDriver> csv = { make_driver(L"", L"NEW", 0x0A000201, 1) };
+
+	const ImportEngine::ImportResult result = ImportEngine::merge_drivers(DriverTable(registry), DriverTable(csv));
+	CHECK(result.success);
+	CHECK(result.updated_drivers.empty());
+	CHECK(result.new_drivers.size() == 1);
+	CHECK(result.new_drivers.size() == 1 && result.new_drivers[0].key_name.view() == L"AB_ETH-3");
+}
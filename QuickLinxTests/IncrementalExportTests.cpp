@@ -0,0 +1,260 @@
+#include "Test.h"
+#include "IncrementalExport.h"
+#include "CSV.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+
+namespace
+{
+	// An in-memory registry: keys in enumeration order, each with a stamp and a driver
+	struct FakeRegistry
+	{
+		struct Key
+		{
+			std::uint64_t	last_write;
+			EthDriver		driver;
+		};
+
+		std::map<std::wstring, Key>		keys;
+		std::size_t						loads = 0;			// load_driver calls
+
+		void set(const wchar_t* key_name, std::uint64_t last_write, const wchar_t* name, std::uint32_t first_node, std::uint32_t count)
+		{
+			EthDriver driver = {};
+			driver.key_name = DriverName(key_name);
+			driver.name = DriverName(name);
+			driver.station = 63;
+			for (std::uint32_t n = 0; n < count; ++n)
+				driver.nodes.push_back(first_node + n);
+			keys[key_name] = { last_write, driver };
+		}
+
+		IncrementalExport::DriverSource source()
+		{
+			IncrementalExport::DriverSource source;
+			source.enumerate_keys = [this](const IncrementalExport::DriverSource::KeyCallback& onKey)
+				{
+					for (const auto& key : keys)
+					{
+						if (!onKey(key.first, key.second.last_write))
+							break;
+					}
+				};
+			source.load_driver = [this](const std::wstring& key_name, EthDriver& driver)
+				{
+					++loads;
+					const auto found = keys.find(key_name);
+					if (found == keys.end())
+						return false;
+					driver = found->second.driver;
+					return true;
+				};
+			return source;
+		}
+
+		// What a full export of these drivers writes
+		std::string full_export() const
+		{
+			std::vector<EthDriver> drivers;
+			for (const auto& key : keys)
+				drivers.push_back(key.second.driver);
+
+			const std::wstring path = Test::temp_file(L"QuickLinxTests-full.csv", "");
+			std::wstring error;
+			CHECK(CSV::write_drivers_to_file(path, drivers, error));
+			std::string contents = read_file(path);
+			std::filesystem::remove(path);
+			return contents;
+		}
+
+		static std::string read_file(const std::wstring& path)
+		{
+			std::ifstream file(std::filesystem::path(path), std::ios::binary);
+			return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		}
+	};
+
+	// A registry of three drivers and a fresh export path (no CSV, no sidecar)
+	struct Fixture
+	{
+		FakeRegistry	registry;
+		std::wstring	path;
+
+		Fixture()
+		{
+			registry.set(L"AB_ETH-1", 100, L"PLANT", 0x0A000001, 3);
+			registry.set(L"AB_ETH-2", 200, L"LINE-2", 0x0A000101, 40);
+			registry.set(L"AB_ETH-3", 300, L"LINE-3", 0x0A000201, 1);
+
+			path = (std::filesystem::temp_directory_path() / L"QuickLinxTests-incremental.csv").wstring();
+			remove_all();
+		}
+
+		~Fixture() { remove_all(); }
+
+		void remove_all()
+		{
+			for (const wchar_t* suffix : { L"", L".qlxstate", L".tmp", L".qlxstate.tmp" })
+				std::filesystem::remove(std::filesystem::path(path + suffix));
+		}
+
+		IncrementalExport::ExportResult run()
+		{
+			registry.loads = 0;
+			return IncrementalExport::export_drivers(path, registry.source());
+		}
+
+		bool exported_in_full() const
+		{
+			return FakeRegistry::read_file(path) == registry.full_export();
+		}
+
+		bool no_temp_files() const
+		{
+			return !std::filesystem::exists(std::filesystem::path(path + L".tmp")) &&
+				   !std::filesystem::exists(std::filesystem::path(path + L".qlxstate.tmp"));
+		}
+
+		// Edit the CSV behind the sidecar's back (the size changes, so the edit is always seen)
+		void touch_csv()
+		{
+			std::ofstream(std::filesystem::path(path), std::ios::binary | std::ios::app) << "\n";
+		}
+	};
+}
+
+// The first export reads every driver and leaves a sidecar; an unchanged
+// registry is then exported from the old file alone
+TEST(incremental_export_unchanged)
+{
+	Fixture fixture;
+
+	IncrementalExport::ExportResult result = fixture.run();
+	CHECK(result.success);
+	CHECK(result.reread == 3 && result.reused == 0 && fixture.registry.loads == 3);
+	CHECK(fixture.exported_in_full());
+	CHECK(std::filesystem::exists(std::filesystem::path(fixture.path + L".qlxstate")));
+	CHECK(fixture.no_temp_files());
+
+	result = fixture.run();
+	CHECK(result.success);
+	CHECK(result.reread == 0 && result.reused == 3 && fixture.registry.loads == 0);
+	CHECK(fixture.exported_in_full());
+	CHECK(fixture.no_temp_files());
+}
+
+// Only the driver whose stamp moved is read again; its rows change size
+// so every later driver's offset moves too
+TEST(incremental_export_changed_driver)
+{
+	Fixture fixture;
+	CHECK(fixture.run().success);
+
+	fixture.registry.set(L"AB_ETH-1", 101, L"PLANT", 0xC0A80001, 200);
+	fixture.registry.set(L"AB_ETH-4", 400, L"NEW", 0x0A000301, 2);
+
+	IncrementalExport::ExportResult result = fixture.run();
+	CHECK(result.success);
+	CHECK(result.reread == 2 && result.reused == 2 && fixture.registry.loads == 2);
+	CHECK(fixture.exported_in_full());
+
+	// The new sidecar describes the new file
+	result = fixture.run();
+	CHECK(result.reread == 0 && result.reused == 4);
+	CHECK(fixture.exported_in_full());
+}
+
+TEST(incremental_export_deleted_driver)
+{
+	Fixture fixture;
+	CHECK(fixture.run().success);
+
+	fixture.registry.keys.erase(L"AB_ETH-2");
+
+	IncrementalExport::ExportResult result = fixture.run();
+	CHECK(result.success);
+	CHECK(result.reread == 0 && result.reused == 2 && fixture.registry.loads == 0);
+	CHECK(fixture.exported_in_full());
+
+	// A key that cannot be loaded drops out the same way
+	fixture.registry.keys[L"AB_ETH-3"].last_write = 301;
+	IncrementalExport::DriverSource source = fixture.registry.source();
+	source.load_driver = [](const std::wstring&, EthDriver&) { return false; };
+
+	result = IncrementalExport::export_drivers(fixture.path, source);
+	CHECK(result.success);
+	CHECK(result.reread == 0 && result.reused == 1);
+	fixture.registry.keys.erase(L"AB_ETH-3");
+	CHECK(fixture.exported_in_full());
+}
+
+// A damaged sidecar is ignored (everything re-read) and replaced
+TEST(incremental_export_corrupt_sidecar)
+{
+	Fixture fixture;
+	CHECK(fixture.run().success);
+
+	const std::wstring state = fixture.path + L".qlxstate";
+	const std::string good = FakeRegistry::read_file(state);
+	CHECK(good.size() > 40);
+
+	const std::string damaged[] = {
+		"not a sidecar",
+		good.substr(0, good.size() - 3),					// Cut short inside the last key name
+		std::string(4, 'X') + good.substr(4),				// Wrong magic
+	};
+
+	for (const std::string& contents : damaged)
+	{
+		std::ofstream(std::filesystem::path(state), std::ios::binary | std::ios::trunc) << contents;
+
+		IncrementalExport::ExportResult result = fixture.run();
+		CHECK(result.success);
+		CHECK(result.reread == 3 && result.reused == 0);
+		CHECK(fixture.exported_in_full());
+
+		result = fixture.run();
+		CHECK(result.reread == 0 && result.reused == 3);
+	}
+}
+
+// A CSV edited after the export, or a missing sidecar, means a full re-read
+TEST(incremental_export_stale_or_missing_state)
+{
+	Fixture fixture;
+	CHECK(fixture.run().success);
+
+	fixture.touch_csv();
+	IncrementalExport::ExportResult result = fixture.run();
+	CHECK(result.reread == 3 && result.reused == 0);
+	CHECK(fixture.exported_in_full());
+
+	std::filesystem::remove(std::filesystem::path(fixture.path + L".qlxstate"));
+	result = fixture.run();
+	CHECK(result.reread == 3 && result.reused == 0);
+	CHECK(fixture.exported_in_full());
+
+	// The CSV itself gone: the sidecar alone is not enough
+	std::filesystem::remove(std::filesystem::path(fixture.path));
+	result = fixture.run();
+	CHECK(result.reread == 3 && result.reused == 0);
+	CHECK(fixture.exported_in_full());
+}
+
+// With no drivers nothing is written and an existing export is left alone
+TEST(incremental_export_empty_registry)
+{
+	Fixture fixture;
+	CHECK(fixture.run().success);
+	const std::string before = FakeRegistry::read_file(fixture.path);
+
+	fixture.registry.keys.clear();
+	const IncrementalExport::ExportResult result = fixture.run();
+	CHECK(result.success);
+	CHECK(result.reread == 0 && result.reused == 0);
+	CHECK(FakeRegistry::read_file(fixture.path) == before);
+	CHECK(fixture.no_temp_files());
+}
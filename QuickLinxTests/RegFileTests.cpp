@@ -0,0 +1,438 @@
+#include "Test.h"
+#include "RegFile.h"
+#include "RegistryLayout.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+	EthDriver make_driver(const wchar_t* key_name, const wchar_t* name, std::uint32_t first_node, std::uint32_t count)
+	{
+		EthDriver driver = {};
+		driver.key_name = DriverName(key_name);
+		driver.name = DriverName(name);
+		driver.station = 63;
+		driver.ping_timeout = 15;
+		driver.inactivity_timeout = 30;
+		driver.startup = 1;
+		for (std::uint32_t n = 0; n < count; ++n)
+			driver.nodes.push_back(first_node + n);
+		return driver;
+	}
+
+	bool same_driver(const EthDriver& driver, const EthDriver& expected)
+	{
+		return driver.key_name == expected.key_name &&
+			   driver.name == expected.name &&
+			   driver.station == expected.station &&
+			   driver.ping_timeout == expected.ping_timeout &&
+			   driver.inactivity_timeout == expected.inactivity_timeout &&
+			   driver.startup == expected.startup &&
+			   std::equal(driver.nodes.begin(), driver.nodes.end(), expected.nodes.begin(), expected.nodes.end()) &&
+			   driver.extra_nodes == expected.extra_nodes;
+	}
+
+	std::wstring temp_path(const wchar_t* name)
+	{
+		return (std::filesystem::temp_directory_path() / name).wstring();
+	}
+
+	// Write drivers with RegFile::Writer and parse the file back
+	std::vector<EthDriver> round_trip(const std::vector<EthDriver>& drivers)
+	{
+		const std::wstring path = temp_path(L"QuickLinxTests-round-trip.reg");
+		std::wstring error;
+		CHECK(RegFile::write_drivers_to_file(path, drivers, error));
+
+		std::vector<EthDriver> read;
+		CHECK(RegFile::read_drivers_from_file(path, read, error));
+		std::filesystem::remove(std::filesystem::path(path));
+		return read;
+	}
+
+	// A written .reg file decoded back to text (UTF-16LE after a BOM)
+	std::wstring read_text(const std::wstring& path)
+	{
+		std::ifstream file(std::filesystem::path(path), std::ios::binary);
+		const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		std::wstring text;
+		if (bytes.size() < 2 || bytes[0] != '\xFF' || bytes[1] != '\xFE')
+			return text;
+		for (std::size_t i = 2; i + 1 < bytes.size(); i += 2)
+			text.push_back(static_cast<wchar_t>(static_cast<unsigned char>(bytes[i]) | (static_cast<unsigned char>(bytes[i + 1]) << 8)));
+		return text;
+	}
+}
+
+// Every field survives a write and a parse, across slot 63 and with text entries
+TEST(regfile_round_trip)
+{
+	std::vector<EthDriver> drivers;
+	drivers.push_back(make_driver(L"AB_ETH-1", L"PLANT", 0x0A000001, 3));
+	drivers.push_back(make_driver(L"AB_ETH-2", L"LINE-2", 0xC0A80001, 200));
+	drivers[1].station = 12;
+	drivers[1].ping_timeout = 0xDEADBEEF;
+	drivers[1].startup = 0;
+
+	drivers.push_back(make_driver(L"AB_ETH-7", L"HOSTS", 0x0A000101, 2));
+	drivers[2].extra_nodes.push_back({ 0, L"plc-1.local" });
+	drivers[2].extra_nodes.push_back({ 1, L"PLC-2" });
+	drivers[2].extra_nodes.push_back({ 2, L"PLC-3" });
+
+	const std::vector<EthDriver> read = round_trip(drivers);
+	CHECK(read.size() == drivers.size());
+	for (std::size_t i = 0; i < std::min(read.size(), drivers.size()); ++i)
+		CHECK(same_driver(read[i], drivers[i]));
+}
+
+// " and \ in the Name and in Node Table text are escaped and come back as written
+TEST(regfile_round_trip_escapes)
+{
+	std::vector<EthDriver> drivers;
+	drivers.push_back(make_driver(L"AB_ETH-1", L"A\"B\\C\\\\D\"", 0x0A000001, 1));
+	drivers[0].extra_nodes.push_back({ 0, L"\\\\server\\plc \"7\"" });
+	drivers[0].extra_nodes.push_back({ 1, L"\\" });
+	drivers[0].extra_nodes.push_back({ 1, L"caf\u00E9-\u20AC" });
+
+	const std::vector<EthDriver> read = round_trip(drivers);
+	CHECK(read.size() == 1);
+	if (read.size() == 1)
+		CHECK(same_driver(read[0], drivers[0]));
+}
+
+// The file uses the SaveDriver layout: the Node Table is deleted before it
+// is written again, and value 63 is skipped
+TEST(regfile_write_layout)
+{
+	std::vector<EthDriver> drivers;
+	drivers.push_back(make_driver(L"AB_ETH-3", L"PLANT", 0x0A000001, 65));
+
+	const std::wstring path = temp_path(L"QuickLinxTests-layout.reg");
+	std::wstring error;
+	CHECK(RegFile::write_drivers_to_file(path, drivers, error));
+	const std::wstring text = read_text(path);
+	std::filesystem::remove(std::filesystem::path(path));
+
+	const std::wstring key = std::wstring(RegistryLayout::ROOT_NAME) + L"\\" + RegistryLayout::AB_ETH_BASE + L"\\AB_ETH-3";
+	CHECK(text.rfind(L"Windows Registry Editor Version 5.00\r\n\r\n", 0) == 0);
+	CHECK(text.find(L"[" + key + L"]\r\n\"Name\"=\"PLANT\"\r\n\"Station\"=dword:0000003f\r\n") != std::wstring::npos);
+
+	const std::size_t deleted = text.find(L"[-" + key + L"\\Node Table]");
+	const std::size_t created = text.find(L"[" + key + L"\\Node Table]");
+	CHECK(deleted != std::wstring::npos && created != std::wstring::npos && deleted < created);
+
+	CHECK(text.find(L"\"62\"=\"10.0.0.63\"\r\n\"64\"=\"10.0.0.64\"\r\n") != std::wstring::npos);
+	CHECK(text.find(L"\"63\"=") == std::wstring::npos);
+	CHECK(text.find(L"\"65\"=\"10.0.0.65\"") != std::wstring::npos);
+}
+
+// Text entries are written back between the addresses they were read with,
+// so a load and save leaves every Node Table value where it was
+TEST(regfile_write_keeps_text_node_slots)
+{
+	std::vector<EthDriver> drivers;
+	drivers.push_back(make_driver(L"AB_ETH-1", L"HOSTS", 0x0A000001, 2));
+	drivers[0].extra_nodes.push_back({ 0, L"plc-0" });
+	drivers[0].extra_nodes.push_back({ 1, L"plc-1" });
+
+	const std::wstring path = temp_path(L"QuickLinxTests-slots.reg");
+	std::wstring error;
+	CHECK(RegFile::write_drivers_to_file(path, drivers, error));
+	const std::wstring text = read_text(path);
+
+	std::vector<EthDriver> read;
+	CHECK(RegFile::read_drivers_from_file(path, read, error));
+	std::filesystem::remove(std::filesystem::path(path));
+
+	CHECK(text.find(L"\"0\"=\"plc-0\"\r\n\"1\"=\"10.0.0.1\"\r\n\"2\"=\"plc-1\"\r\n\"3\"=\"10.0.0.2\"\r\n") != std::wstring::npos);
+	CHECK(read.size() == 1);
+	CHECK(read.size() == 1 && same_driver(read[0], drivers[0]));
+}
+
+// Per-host files written on several threads each hold their own drivers
+TEST(regfile_write_host_files)
+{
+	std::vector<std::vector<EthDriver>> sets(5);
+	std::vector<RegFile::HostFile> files;
+	std::vector<std::wstring> paths;
+	for (std::size_t i = 0; i < sets.size(); ++i)
+	{
+		for (std::uint32_t d = 0; d <= i; ++d)
+		{
+			const std::wstring key_name = L"AB_ETH-" + std::to_wstring(d + 1);
+			sets[i].push_back(make_driver(key_name.c_str(), L"HOST", 0x0A000000 + static_cast<std::uint32_t>(i << 8), d + 1));
+		}
+		paths.push_back(temp_path((L"QuickLinxTests-host-" + std::to_wstring(i) + L".reg").c_str()));
+		files.push_back({ paths.back(), &sets[i] });
+	}
+
+	std::vector<std::wstring> errors;
+	CHECK(RegFile::write_host_files(files, errors, 3));
+	CHECK(errors.empty());
+
+	for (std::size_t i = 0; i < sets.size(); ++i)
+	{
+		std::vector<EthDriver> read;
+		std::wstring error;
+		CHECK(RegFile::read_drivers_from_file(paths[i], read, error));
+		std::filesystem::remove(std::filesystem::path(paths[i]));
+
+		CHECK(read.size() == sets[i].size());
+		for (std::size_t d = 0; d < std::min(read.size(), sets[i].size()); ++d)
+			CHECK(same_driver(read[d], sets[i][d]));
+	}
+}
+
+namespace
+{
+	// regedit 5.00 text with each '$' standing for the AB_ETH key path, as UTF-16LE after a BOM
+	std::string reg_file(std::wstring_view body)
+	{
+		const std::wstring base = std::wstring(RegistryLayout::ROOT_NAME) + L"\\" + RegistryLayout::AB_ETH_BASE;
+
+		std::wstring text = L"Windows Registry Editor Version 5.00\r\n\r\n";
+		for (const wchar_t c : body)
+		{
+			if (c == L'$')
+				text += base;
+			else if (c == L'\n')
+				text += L"\r\n";
+			else
+				text += c;
+		}
+
+		std::string bytes = "\xFF\xFE";
+		for (const wchar_t c : text)
+		{
+			bytes += static_cast<char>(c & 0xFF);
+			bytes += static_cast<char>((c >> 8) & 0xFF);
+		}
+		return bytes;
+	}
+
+	std::vector<EthDriver> parse(const std::string& contents)
+	{
+		const std::wstring path = Test::temp_file(L"QuickLinxTests-parse.reg", contents);
+		std::vector<EthDriver> drivers;
+		std::wstring error;
+		CHECK(RegFile::read_drivers_from_file(path, drivers, error));
+		CHECK(error.empty());
+		std::filesystem::remove(std::filesystem::path(path));
+		return drivers;
+	}
+
+	bool has_nodes(const EthDriver& driver, std::initializer_list<std::uint32_t> nodes)
+	{
+		return std::equal(driver.nodes.begin(), driver.nodes.end(), nodes.begin(), nodes.end());
+	}
+}
+
+// regedit writes " and \ escaped inside quoted names and strings
+TEST(regfile_parse_escapes)
+{
+	const std::vector<EthDriver> drivers = parse(reg_file(
+		L"[$\\AB_ETH-1]\n"
+		L"\"Name\"=\"A\\\"B\\\\C\"\n"
+		L"\"Station\"=dword:00000001\n"
+		L"\n"
+		L"[$\\AB_ETH-1\\Node Table]\n"
+		L"\"0\"=\"\\\\\\\\server\\\\plc\"\n"
+		L"\"1\"=\"say \\\"hi\\\"\"\n"));
+
+	CHECK(drivers.size() == 1);
+	if (drivers.size() != 1)
+		return;
+
+	CHECK(drivers[0].name.view() == L"A\"B\\C");
+	CHECK(drivers[0].extra_nodes.size() == 2);
+	CHECK(drivers[0].extra_nodes.size() == 2 && drivers[0].extra_nodes[0].text == L"\\\\server\\plc" && drivers[0].extra_nodes[1].text == L"say \"hi\"");
+}
+
+// hex(2) (REG_EXPAND_SZ) values are UTF-16LE bytes, often split across '\'
+// continuation lines; other hex types are skipped along with their continuations
+TEST(regfile_parse_hex_continuation)
+{
+	const std::vector<EthDriver> drivers = parse(reg_file(
+		L"[$\\AB_ETH-1]\n"
+		L"\"Name\"=hex(2):50,00,4c,00,41,00,\\\n"
+		L"  4e,00,54,00,00,00\n"
+		L"\"Station\"=dword:0000003f\n"
+		L"\"Blob\"=hex:01,02,03,\\\n"
+		L"  \"Startup\"=dword:00000001\n"
+		L"\n"
+		L"[$\\AB_ETH-1\\Node Table]\n"
+		L"\"0\"=hex(2):31,00,30,00,2e,00,30,00,2e,00,30,00,2e,00,39,00,\\\n"
+		L"  00,00\n"
+		L"\"1\"=hex(2):70,00,6c,00,\\\n"
+		L"  63,00,2d,00,\\\n"
+		L"  37,00,00,00\n"
+		L"\"2\"=hex(7):41,00,00,00,\\\n"
+		L"  00,00\n"
+		L"\"3\"=\"10.0.0.10\"\n"));
+
+	CHECK(drivers.size() == 1);
+	if (drivers.size() != 1)
+		return;
+
+	CHECK(drivers[0].name.view() == L"PLANT");
+	CHECK(drivers[0].station == 63);
+	CHECK(drivers[0].startup == 0);				// The Startup text was a continuation of Blob
+	CHECK(has_nodes(drivers[0], { 0x0A000009, 0x0A00000A }));
+	CHECK(drivers[0].extra_nodes == (std::vector<TextNode>{ { 1, L"plc-7" } }));
+}
+
+// [-key] deletes a driver or its Node Table and "value"=- deletes one value,
+// in file order
+TEST(regfile_parse_deletions)
+{
+	const std::vector<EthDriver> drivers = parse(reg_file(
+		L"[$\\AB_ETH-1]\n"
+		L"\"Name\"=\"PLANT\"\n"
+		L"\"Station\"=dword:00000001\n"
+		L"\"Ping Timeout\"=dword:0000000f\n"
+		L"[$\\AB_ETH-1\\Node Table]\n"
+		L"\"0\"=\"10.0.0.1\"\n"
+		L"\"1\"=\"plc-1\"\n"
+		L"\n"
+		L"[$\\AB_ETH-2]\n"
+		L"\"Name\"=\"GONE\"\n"
+		L"\"Station\"=dword:00000002\n"
+		L"\n"
+		L"[$\\AB_ETH-3]\n"
+		L"\"Name\"=\"UNNAMED\"\n"
+		L"\"Station\"=dword:00000003\n"
+		L"\n"
+		L"[$\\AB_ETH-4]\n"
+		L"\"Name\"=\"OLD\"\n"
+		L"\"Station\"=dword:00000004\n"
+		L"\"Startup\"=dword:00000001\n"
+		L"\n"
+		L"; Later changes\n"
+		L"[-$\\AB_ETH-1\\Node Table]\n"
+		L"[$\\AB_ETH-1\\Node Table]\n"
+		L"\"0\"=\"10.0.0.2\"\n"
+		L"[$\\AB_ETH-1]\n"
+		L"\"Ping Timeout\"=-\n"
+		L"[-$\\AB_ETH-2]\n"
+		L"[$\\AB_ETH-3]\n"
+		L"\"Name\"=-\n"
+		L"[-$\\AB_ETH-4]\n"
+		L"[$\\AB_ETH-4]\n"
+		L"\"Name\"=\"NEW\"\n"
+		L"\"Station\"=dword:00000005\n"));
+
+	CHECK(drivers.size() == 2);
+	if (drivers.size() != 2)
+		return;
+
+	CHECK(drivers[0].key_name.view() == L"AB_ETH-1");
+	CHECK(drivers[0].station == 1 && drivers[0].ping_timeout == 0);
+	CHECK(has_nodes(drivers[0], { 0x0A000002 }));
+	CHECK(drivers[0].extra_nodes.empty());
+
+	// Deleted and created again: nothing of the old key is left
+	CHECK(drivers[1].key_name.view() == L"AB_ETH-4");
+	CHECK(drivers[1].name.view() == L"NEW");
+	CHECK(drivers[1].station == 5 && drivers[1].startup == 0);
+}
+
+// Deleting the AB_ETH key itself drops every driver before it
+TEST(regfile_parse_delete_all)
+{
+	const std::vector<EthDriver> drivers = parse(reg_file(
+		L"[$\\AB_ETH-1]\n"
+		L"\"Name\"=\"PLANT\"\n"
+		L"\"Station\"=dword:00000001\n"
+		L"[-$]\n"
+		L"[$\\AB_ETH-2]\n"
+		L"\"Name\"=\"LINE-2\"\n"
+		L"\"Station\"=dword:00000002\n"));
+
+	CHECK(drivers.size() == 1);
+	CHECK(drivers.size() == 1 && drivers[0].name.view() == L"LINE-2");
+}
+
+// REGEDIT4 files are 8-bit, and a 32-bit install has no WOW6432Node
+TEST(regfile_parse_regedit4_native_path)
+{
+	const std::vector<EthDriver> drivers = parse(
+		"REGEDIT4\r\n\r\n"
+		"[HKEY_LOCAL_MACHINE\\SOFTWARE\\Rockwell Software\\RSLinx\\Drivers\\AB_ETH\\AB_ETH-1]\r\n"
+		"\"Name\"=\"CAF\xC9\"\r\n"
+		"\"Station\"=dword:00000007\r\n"
+		"\r\n"
+		"[HKEY_LOCAL_MACHINE\\SOFTWARE\\Rockwell Software\\RSLinx\\Drivers\\AB_ETH\\AB_ETH-1\\Node Table]\r\n"
+		"\"0\"=\"192.168.1.1\"\r\n"
+		"[HKEY_LOCAL_MACHINE\\SOFTWARE\\Other\\AB_ETH-2]\r\n"
+		"\"Name\"=\"OTHER\"\r\n"
+		"\"Station\"=dword:00000008\r\n");
+
+	CHECK(drivers.size() == 1);
+	if (drivers.size() != 1)
+		return;
+
+	CHECK(drivers[0].name.view() == L"CAF\u00C9");
+	CHECK(drivers[0].station == 7);
+	CHECK(has_nodes(drivers[0], { 0xC0A80101 }));
+}
+
+// Results come back in path order whatever order the workers finish in
+TEST(regfile_read_snapshots)
+{
+	std::vector<std::wstring> paths;
+	for (int i = 0; i < 6; ++i)
+	{
+		const std::wstring station = std::to_wstring(i);
+		const std::wstring name = L"QuickLinxTests-snapshot-" + station + L".reg";
+		paths.push_back(Test::temp_file(name.c_str(), reg_file(
+			L"[$\\AB_ETH-1]\n\"Name\"=\"HOST-" + station + L"\"\n\"Station\"=dword:0000000" + station + L"\n")));
+	}
+	paths.push_back(Test::temp_file(L"QuickLinxTests-snapshot-bad.reg", "Type,Name,Range\r\n"));
+	paths.push_back(temp_path(L"QuickLinxTests-snapshot-missing.reg"));
+
+	const std::vector<RegFile::Snapshot> snapshots = RegFile::read_snapshots(paths, 3);
+	for (const std::wstring& path : paths)
+		std::filesystem::remove(std::filesystem::path(path));
+
+	CHECK(snapshots.size() == paths.size());
+	if (snapshots.size() != paths.size())
+		return;
+
+	for (std::size_t i = 0; i < 6; ++i)
+	{
+		CHECK(snapshots[i].path == paths[i]);
+		CHECK(snapshots[i].success && snapshots[i].error.empty());
+		CHECK(snapshots[i].drivers.size() == 1);
+		CHECK(snapshots[i].drivers.size() == 1 && snapshots[i].drivers[0].station == i);
+	}
+	CHECK(!snapshots[6].success && snapshots[6].error.find(L"Not a registry export") != std::wstring::npos);
+	CHECK(!snapshots[7].success && snapshots[7].error.find(L"Failed to open") != std::wstring::npos);
+}
+
+// A Name over the RSLinx limit keeps its driver, as the registry read does,
+// and writes back in full
+TEST(regfile_keeps_long_names)
+{
+	const std::vector<EthDriver> drivers = parse(reg_file(
+		L"[$\\AB_ETH-1]\n"
+		L"\"Name\"=\"Packaging-Line-07\"\n"
+		L"\"Station\"=dword:00000001\n"
+		L"[$\\AB_ETH-2]\n"
+		L"\"Name\"=\"LINE-2\"\n"
+		L"\"Station\"=dword:00000002\n"));
+
+	CHECK(drivers.size() == 2);
+	if (drivers.size() != 2)
+		return;
+
+	CHECK(drivers[0].key_name.view() == L"AB_ETH-1");
+	CHECK(drivers[0].name.view() == L"Packaging-Line-07");
+
+	const std::vector<EthDriver> read = round_trip(drivers);
+	CHECK(read.size() == 2);
+	CHECK(read.size() == 2 && same_driver(read[0], drivers[0]));
+}
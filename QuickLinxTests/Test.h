@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+	File: Test.h
+
+	Description:
+		The few pieces QuickLinxTests needs in place of a test framework.
+
+		TEST(name) defines a test case and registers it with the runner
+		in main.cpp; CHECK(expr) records a failure (file, line and the
+		expression) and lets the case carry on. The program exits
+		non-zero if any check failed.
+
+		Tests that need a file write one with temp_file() and remove it
+		themselves.
+*/
+
+namespace Test
+{
+	struct Case
+	{
+		const char*		name;
+		void			(*run)();
+	};
+
+	// Every TEST in the program, in registration order
+	std::vector<Case>& cases();
+
+	struct Register
+	{
+		Register(const char* name, void (*run)()) { cases().push_back({ name, run }); }
+	};
+
+	void fail(const char* file, int line, const char* expression);
+
+	// Write contents to a file in the system temp directory and return its path
+	std::wstring temp_file(const wchar_t* name, std::string_view contents);
+}
+
+#define TEST(name) \
+	static void name(); \
+	static const Test::Register name##_registration(#name, name); \
+	static void name()
+
+#define CHECK(expression) \
+	do { if (!(expression)) Test::fail(__FILE__, __LINE__, #expression); } while (0)
@@ -0,0 +1,64 @@
+#include "Test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+/*
+	QuickLinxTests [name]
+
+	Runs every test case, or only the one named, and prints each
+	failed check. Exits 0 when every check passed.
+*/
+
+namespace
+{
+	int g_failures = 0;
+}
+
+namespace Test
+{
+	std::vector<Case>& cases()
+	{
+		static std::vector<Case> all;
+		return all;
+	}
+
+	void fail(const char* file, int line, const char* expression)
+	{
+		std::printf("  %s(%d): CHECK(%s) failed\n", file, line, expression);
+		++g_failures;
+	}
+
+	std::wstring temp_file(const wchar_t* name, std::string_view contents)
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+		return path.wstring();
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const char* only = (argc > 1) ? argv[1] : nullptr;
+
+	int run = 0;
+	int failed = 0;
+	for (const Test::Case& test : Test::cases())
+	{
+		if (only != nullptr && std::strcmp(only, test.name) != 0)
+			continue;
+
+		const int before = g_failures;
+		std::printf("%s\n", test.name);
+		test.run();
+		++run;
+		if (g_failures != before)
+			++failed;
+	}
+
+	std::printf("%d of %d tests passed\n", run - failed, run);
+	return (failed == 0 && run > 0) ? 0 : 1;
+}